@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    The parts of the spectrum analyzer that don't need JUCE.
+
+    Plain C++ on purpose, like FrequencyResponse.h, so tools and benchmarks
+    (see Tools/) can use them. PluginEditor.h builds the analyzer on top.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/*
+ one FFT frame as it travels from the FFTDataGenerator to the path generator.
+ only the numBins bins the analyzer draws are kept, each quantised to a
+ SampleType code spanning [negativeInfinity, 0] dB, so a frame at order 2048 is
+ 1024 * 2 bytes instead of the 4096 floats the FFT works on.
+ */
+template<typename SampleType>
+struct QuantisedFFTFrame
+{
+    static_assert( std::is_integral_v<SampleType> && std::is_unsigned_v<SampleType>,
+                  "QuantisedFFTFrame codes should be an unsigned integer type (uint8_t or uint16_t)");
+
+    static constexpr float maxCode = (float) std::numeric_limits<SampleType>::max();
+
+    // called by Fifo::prepare(numElements), so every slot is allocated once up front
+    void prepare(size_t maxNumBins)
+    {
+        bins.clear();
+        bins.resize(maxNumBins, 0);
+        numBins = 0;
+    }
+
+    // converts decibel values into codes. never reallocates as long as num <= the prepared size
+    void quantise(const float* decibels, int num, float negativeInfinity)
+    {
+        assert( num <= (int) bins.size() );
+        numBins = std::min(num, (int) bins.size());
+
+        const auto scale = maxCode / -negativeInfinity;
+
+        for (int i = 0; i < numBins; ++i)
+        {
+            auto code = (decibels[i] - negativeInfinity) * scale;
+            bins[i] = (SampleType) std::clamp(code + 0.5f, 0.f, maxCode);
+        }
+    }
+
+    float getDecibels(int bin, float negativeInfinity) const
+    {
+        return negativeInfinity - negativeInfinity * (float) bins[bin] / maxCode;
+    }
+
+    int getNumBins() const { return numBins; }
+    const SampleType* getCodes() const { return bins.data(); }
+
+    // bytes copied whenever a frame of this size is handed on
+    size_t getSizeInBytes() const { return bins.size() * sizeof(SampleType); }
+private:
+    int numBins = 0;
+    std::vector<SampleType> bins;
+};
+
+// 16 bit codes give ~0.0007dB steps over the 48dB display range, 8 bit codes would give ~0.19dB
+using FFTFrame = QuantisedFFTFrame<uint16_t>;
+
+/*
+ fused normalise + clamp + decibel conversion for FFT power values (|X|^2):
+     decibels[i] = 10 * log10(max(power[i] * scale, power at negativeInfinity))
+ log2 comes from the float's exponent plus a cubic on its mantissa, good to ~0.0025dB
+ against juce::Decibels::gainToDecibels. the loop has no branches or calls, so the
+ compiler vectorises it.
+ */
+inline void powerToDecibels(const float* power, float* decibels, int numValues, float scale, float negativeInfinity)
+{
+    const auto floorPower = std::pow(10.f, negativeInfinity / 10.f);
+
+    constexpr float decibelsPerOctave = 3.0102999566f; // 10 * log10(2)
+    constexpr float c1 = 1.4245937f, c2 = -0.58920605f, c3 = 0.16538325f;
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        auto x = std::max(power[i] * scale, floorPower);
+
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+
+        auto exponent = (float) ((int32_t) (bits >> 23) - 127);
+
+        uint32_t mantissaBits = (bits & 0x007fffffu) | 0x3f800000u;
+        float mantissa;
+        std::memcpy(&mantissa, &mantissaBits, sizeof(mantissa));
+
+        auto t = mantissa - 1.f;
+        decibels[i] = (exponent + t * (c1 + t * (c2 + t * c3))) * decibelsPerOctave;
+    }
+}
+
+/*
+ separates the first fftSize / 2 bins of a real-pair FFT (left in the real part, right in
+ the imaginary part, see FFTDataGenerator) into the power of its two channels,
+ |2 L[k]|^2 and |2 R[k]|^2, or of mid and side when midSide is set
+ */
+inline void separateRealPairPowers(const std::complex<float>* spectrum,
+                                   int fftSize,
+                                   bool midSide,
+                                   float* first,
+                                   float* second)
+{
+    using Complex = std::complex<float>;
+
+    const int numBins = fftSize / 2;
+
+    for (int k = 0; k < numBins; ++k)
+    {
+        auto z = spectrum[k];
+        auto zMirror = std::conj(spectrum[(fftSize - k) & (fftSize - 1)]);
+
+        // 2 * L[k] and 2 * R[k]
+        auto l = z + zMirror;
+        auto difference = z - zMirror;
+        auto r = Complex(difference.imag(), -difference.real());
+
+        if ( midSide )
+        {
+            first[k] = std::norm(l + r) * 0.25f;
+            second[k] = std::norm(l - r) * 0.25f;
+        }
+        else
+        {
+            first[k] = std::norm(l);
+            second[k] = std::norm(r);
+        }
+    }
+}
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+    Batched magnitude response of a chain of biquads.
+
+    Plain C++ on purpose, so tools and benchmarks (see Tools/) can use it
+    without JUCE. makeChainSnapshot() in PluginProcessor.h fills a snapshot
+    from a MonoChain.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// one normalised (a0 = 1) biquad. first order sections have b2 = a2 = 0
+struct BiquadCoefficients
+{
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+};
+
+// the biquads that are active in a chain, in any order, and the rate they were designed for
+struct ChainSnapshot
+{
+    // both cuts at 48dB/Oct (4 biquads each) and the peak
+    static constexpr int maxBiquads = 9;
+
+    double sampleRate = 44100.0;
+    int numBiquads = 0;
+    std::array<BiquadCoefficients, maxBiquads> biquads {};
+
+    void add(const BiquadCoefficients& biquad)
+    {
+        if ( numBiquads < maxBiquads )
+            biquads[(size_t) numBiquads++] = biquad;
+    }
+};
+
+/*
+ the frequency dependent part of the response, worked out once per frequency and rate:
+     phi = sin^2(w / 2),  w = 2 pi f / fs
+ every biquad's squared magnitude is then a ratio of two quadratics in phi
+     |H|^2 = ((b0+b1+b2)^2 - 4(b0b1 + 4b0b2 + b1b2) phi + 16 b0b2 phi^2)
+           / ((1+a1+a2)^2  - 4(a1 + 4a2 + a1a2) phi    + 16 a2 phi^2)
+ which needs no complex maths, and doesn't lose the low end of a highpass to cancellation
+ the way the cos(w) form does
+ */
+inline double getResponsePhi(double frequency, double sampleRate)
+{
+    auto s = std::sin(3.14159265358979323846 * frequency / sampleRate);
+    return s * s;
+}
+
+/*
+ squared magnitude of the whole chain at numValues precomputed phis.
+ biquads outside, frequencies inside: the inner loop has no branches or calls, so the
+ compiler runs it several frequencies at a time
+ */
+inline void evaluatePower(const ChainSnapshot& chain, const double* phi, double* power, int numValues)
+{
+    std::fill(power, power + numValues, 1.0);
+
+    for (int i = 0; i < chain.numBiquads; ++i)
+    {
+        const auto& c = chain.biquads[(size_t) i];
+
+        const auto numerator0 = (c.b0 + c.b1 + c.b2) * (c.b0 + c.b1 + c.b2);
+        const auto numerator1 = 4.0 * (c.b0 * c.b1 + 4.0 * c.b0 * c.b2 + c.b1 * c.b2);
+        const auto numerator2 = 16.0 * c.b0 * c.b2;
+
+        const auto denominator0 = (1.0 + c.a1 + c.a2) * (1.0 + c.a1 + c.a2);
+        const auto denominator1 = 4.0 * (c.a1 + 4.0 * c.a2 + c.a1 * c.a2);
+        const auto denominator2 = 16.0 * c.a2;
+
+        for (int k = 0; k < numValues; ++k)
+        {
+            const auto p = phi[k];
+            power[k] *= (numerator0 - p * (numerator1 - numerator2 * p))
+                      / (denominator0 - p * (denominator1 - denominator2 * p));
+        }
+    }
+}
+
+// 10 * log10 of a power, floored well below anything the UI draws
+inline float powerToResponseDecibels(double power)
+{
+    return (float) (10.0 * std::log10(std::max(power, 1.0e-20)));
+}
+
+/*
+ chain magnitude in dB at numValues frequencies (Hz). doesn't allocate: works through
+ the frequencies in chunks on the stack
+ */
+inline void evaluateMagnitude(const ChainSnapshot& chain, const float* frequencies, float* outDecibels, int numValues)
+{
+    constexpr int chunkSize = 256;
+    double phi[chunkSize], power[chunkSize];
+
+    for (int start = 0; start < numValues; start += chunkSize)
+    {
+        const auto num = std::min(chunkSize, numValues - start);
+
+        for (int k = 0; k < num; ++k)
+            phi[k] = getResponsePhi(frequencies[start + k], chain.sampleRate);
+
+        evaluatePower(chain, phi, power, num);
+
+        for (int k = 0; k < num; ++k)
+            outDecibels[start + k] = powerToResponseDecibels(power[k]);
+    }
+}
+
+/*
+ same, for frequencies that are ascending and evenly spaced in log frequency (like pixel columns
+ on the response curve). a coarse grid is evaluated first, then each gap is split only until
+ its midpoint is within toleranceDb of the straight line through its ends, and everything in
+ between is interpolated. smooth stretches cost a handful of evaluations, the corners of the
+ filters still get every point they need
+ */
+inline void evaluateMagnitudeAdaptive(const ChainSnapshot& chain,
+                                      const float* frequencies,
+                                      float* outDecibels,
+                                      int numValues,
+                                      float toleranceDb = 0.05f)
+{
+    constexpr int coarseStep = 16;
+
+    if ( numValues <= 2 * coarseStep )
+    {
+        evaluateMagnitude(chain, frequencies, outDecibels, numValues);
+        return;
+    }
+
+    // coarse grid, batched a chunk at a time, always including the last point
+    {
+        constexpr int chunkSize = 64;
+        float coarseFrequencies[chunkSize], coarseDecibels[chunkSize];
+        int indices[chunkSize];
+        int num = 0;
+
+        auto flush = [&]
+        {
+            evaluateMagnitude(chain, coarseFrequencies, coarseDecibels, num);
+            for (int k = 0; k < num; ++k)
+                outDecibels[indices[k]] = coarseDecibels[k];
+            num = 0;
+        };
+
+        for (int i = 0; i < numValues; i = (i == numValues - 1) ? numValues : std::min(i + coarseStep, numValues - 1))
+        {
+            coarseFrequencies[num] = frequencies[i];
+            indices[num] = i;
+
+            if ( ++num == chunkSize )
+                flush();
+        }
+
+        flush();
+    }
+
+    // refine every coarse gap. at most log2(coarseStep) levels deep
+    struct Refiner
+    {
+        const ChainSnapshot& chain;
+        const float* frequencies;
+        float* outDecibels;
+        float toleranceDb;
+
+        void refine(int first, int last)
+        {
+            if ( last - first < 2 )
+                return;
+
+            const auto middle = (first + last) / 2;
+            evaluateMagnitude(chain, frequencies + middle, outDecibels + middle, 1);
+
+            auto interpolate = [this, first, last](int i)
+            {
+                const auto t = (float) (i - first) / (float) (last - first);
+                return outDecibels[first] + t * (outDecibels[last] - outDecibels[first]);
+            };
+
+            if ( std::abs(outDecibels[middle] - interpolate(middle)) <= toleranceDb )
+            {
+                for (int i = first + 1; i < last; ++i)
+                {
+                    if ( i != middle )
+                        outDecibels[i] = interpolate(i);
+                }
+
+                return;
+            }
+
+            refine(first, middle);
+            refine(middle, last);
+        }
+    };
+
+    Refiner refiner { chain, frequencies, outDecibels, toleranceDb };
+
+    for (int first = 0; first < numValues - 1; first = std::min(first + coarseStep, numValues - 1))
+        refiner.refine(first, std::min(first + coarseStep, numValues - 1));
+}
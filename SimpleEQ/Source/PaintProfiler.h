@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+    Paint time profiler for the editor.
+
+    Off unless the plugin is built with SIMPLEEQ_PAINT_PROFILER=1 (add it to the
+    exporter's preprocessor definitions). Off, SIMPLEEQ_PROFILE_PAINT() compiles
+    to nothing and none of this is built.
+
+    On, every instrumented paint records how long it took into a lock-free
+    histogram for its section. In the editor, P shows or hides an overlay with
+    each section's p50/p99 and how often that editor's response view painted or
+    had nothing new, and D writes the statistics to "SimpleEQ Paint Profile.txt"
+    in the user's documents.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef SIMPLEEQ_PAINT_PROFILER
+ #define SIMPLEEQ_PAINT_PROFILER 0
+#endif
+
+#if SIMPLEEQ_PAINT_PROFILER
+
+#include <array>
+#include <atomic>
+#include <cmath>
+
+enum PaintSection
+{
+    EditorPaint,
+    RotarySliderPaint,      // RotarySliderWithLabels::paint, drawRotarySlider included
+    RotarySliderDrawing,    // LookAndFeel::drawRotarySlider on its own
+    ToggleButtonDrawing,
+    ResponseCurvePaint,
+    SpectrogramPaint,
+    NumPaintSections
+};
+
+inline const char* getPaintSectionName(PaintSection section)
+{
+    switch (section)
+    {
+        case EditorPaint: return "editor";
+        case RotarySliderPaint: return "rotary slider";
+        case RotarySliderDrawing: return "  drawRotarySlider";
+        case ToggleButtonDrawing: return "toggle button";
+        case ResponseCurvePaint: return "response curve";
+        case SpectrogramPaint: return "spectrogram";
+        case NumPaintSections: break;
+    }
+
+    return "unknown";
+}
+
+/*
+ paint durations in log spaced buckets, 4 per octave from 1us, so 64 buckets reach ~65ms and
+ anything longer lands in the last one. record() is a few relaxed atomic adds: whoever reads the
+ statistics never holds up painting, and percentiles are accurate to a quarter octave (~19%)
+ */
+struct PaintHistogram
+{
+    static constexpr int numBuckets = 64;
+    static constexpr int bucketsPerOctave = 4;
+
+    void record(double microseconds)
+    {
+        auto bucket = microseconds <= 1.0 ? 0 : juce::jmin(numBuckets - 1, (int) (std::log2(microseconds) * bucketsPerOctave));
+        auto nanoseconds = (uint64_t) (microseconds * 1000.0);
+
+        counts[(size_t) bucket].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+        auto max = maxNanoseconds.load(std::memory_order_relaxed);
+        while ( nanoseconds > max && ! maxNanoseconds.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed) ) { }
+    }
+
+    // upper edge (us) of the bucket the given fraction of paints were at or under. 0 if nothing was recorded
+    double getPercentile(double fraction) const
+    {
+        std::array<uint32_t, numBuckets> snapshot;
+        uint64_t total = 0;
+
+        for ( size_t i = 0; i < snapshot.size(); ++i )
+        {
+            snapshot[i] = counts[i].load(std::memory_order_relaxed);
+            total += snapshot[i];
+        }
+
+        if ( total == 0 )
+            return 0.0;
+
+        auto target = (uint64_t) std::ceil(fraction * (double) total);
+        uint64_t seen = 0;
+
+        for ( int i = 0; i < numBuckets; ++i )
+        {
+            seen += snapshot[(size_t) i];
+            if ( seen >= target )
+                return getBucketUpperEdge(i);
+        }
+
+        return getBucketUpperEdge(numBuckets - 1);
+    }
+
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+
+    double getMeanMicroseconds() const
+    {
+        auto n = getCount();
+        return n == 0 ? 0.0 : (double) totalNanoseconds.load(std::memory_order_relaxed) / (1000.0 * (double) n);
+    }
+
+    double getMaxMicroseconds() const { return (double) maxNanoseconds.load(std::memory_order_relaxed) / 1000.0; }
+
+    void reset()
+    {
+        for ( auto& c : counts )
+            c.store(0, std::memory_order_relaxed);
+
+        count.store(0, std::memory_order_relaxed);
+        totalNanoseconds.store(0, std::memory_order_relaxed);
+        maxNanoseconds.store(0, std::memory_order_relaxed);
+    }
+
+    static double getBucketUpperEdge(int bucket) { return std::exp2((bucket + 1) / (double) bucketsPerOctave); }
+private:
+    std::array<std::atomic<uint32_t>, numBuckets> counts {};
+    std::atomic<uint64_t> count { 0 }, totalNanoseconds { 0 }, maxNanoseconds { 0 };
+};
+
+// one per process, shared by every open editor
+struct PaintProfiler
+{
+    static PaintProfiler& getInstance()
+    {
+        static PaintProfiler profiler;
+        return profiler;
+    }
+
+    void record(PaintSection section, double microseconds) { histograms[(size_t) section].record(microseconds); }
+
+    const PaintHistogram& getHistogram(PaintSection section) const { return histograms[(size_t) section]; }
+
+    void reset()
+    {
+        for ( auto& histogram : histograms )
+            histogram.reset();
+    }
+
+    // a table of every section, one line each
+    juce::String getReport() const
+    {
+        juce::String report;
+        report << juce::String("section").paddedRight(' ', 20)
+               << juce::String("count").paddedLeft(' ', 9)
+               << juce::String("mean us").paddedLeft(' ', 10)
+               << juce::String("p50 us").paddedLeft(' ', 10)
+               << juce::String("p99 us").paddedLeft(' ', 10)
+               << juce::String("max us").paddedLeft(' ', 10) << juce::newLine;
+
+        for ( int i = 0; i < NumPaintSections; ++i )
+        {
+            const auto& histogram = histograms[(size_t) i];
+
+            report << juce::String(getPaintSectionName(static_cast<PaintSection>(i))).paddedRight(' ', 20)
+                   << juce::String((juce::int64) histogram.getCount()).paddedLeft(' ', 9)
+                   << juce::String(histogram.getMeanMicroseconds(), 1).paddedLeft(' ', 10)
+                   << juce::String(histogram.getPercentile(0.5), 1).paddedLeft(' ', 10)
+                   << juce::String(histogram.getPercentile(0.99), 1).paddedLeft(' ', 10)
+                   << juce::String(histogram.getMaxMicroseconds(), 1).paddedLeft(' ', 10) << juce::newLine;
+        }
+
+        return report;
+    }
+
+    // extraText goes after the table, e.g. the editor's own frame counts
+    bool dumpToFile(const juce::File& file, const juce::String& extraText = {}) const
+    {
+        juce::String text;
+        text << "SimpleEQ paint profile, " << juce::Time::getCurrentTime().toString(true, true) << juce::newLine
+             << juce::newLine
+             << getReport()
+             << extraText;
+
+        return file.replaceWithText(text);
+    }
+
+    // times its scope into a section
+    struct ScopedTimer
+    {
+        explicit ScopedTimer(PaintSection s) : section(s), start(juce::Time::getHighResolutionTicks()) { }
+
+        ~ScopedTimer()
+        {
+            auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+            PaintProfiler::getInstance().record(section, elapsed * 1.0e6);
+        }
+    private:
+        PaintSection section;
+        juce::int64 start;
+    };
+private:
+    std::array<PaintHistogram, NumPaintSections> histograms;
+};
+
+/*
+ the statistics over the editor, refreshed a few times a second. doesn't take mouse clicks.
+ opaque, so JUCE doesn't paint what's underneath when it repaints, and the profiler
+ doesn't time (or count) paints the overlay itself caused
+ */
+struct PaintProfilerOverlay : juce::Component, juce::Timer
+{
+    PaintProfilerOverlay()
+    {
+        setInterceptsMouseClicks(false, false);
+        setOpaque(true);
+    }
+
+    // one editor's response view, counted by the component itself, see ResponseCurveComponent
+    struct ResponseViewFrames
+    {
+        juce::uint64 numPaints = 0, numSkipped = 0;
+    };
+
+    // the profiler is shared by every editor in the process, these counts aren't
+    std::function<ResponseViewFrames()> getResponseViewFrames;
+
+    // shown under the statistics until the next message, e.g. where D wrote the profile to
+    void showMessage(const juce::String& newMessage)
+    {
+        message = newMessage;
+        repaint();
+    }
+
+    void visibilityChanged() override
+    {
+        if ( isVisible() )
+        {
+            lastFrames = getResponseViewFrames != nullptr ? getResponseViewFrames() : ResponseViewFrames();
+            lastTime = juce::Time::getMillisecondCounterHiRes();
+            startTimerHz(4);
+        }
+        else
+        {
+            stopTimer();
+        }
+    }
+
+    void timerCallback() override
+    {
+        auto& profiler = PaintProfiler::getInstance();
+        auto frames = getResponseViewFrames != nullptr ? getResponseViewFrames() : ResponseViewFrames();
+        auto now = juce::Time::getMillisecondCounterHiRes();
+
+        if ( now > lastTime )
+        {
+            paintsPerSecond = 1000.0 * (double) (frames.numPaints - lastFrames.numPaints) / (now - lastTime);
+            skippedPerSecond = 1000.0 * (double) (frames.numSkipped - lastFrames.numSkipped) / (now - lastTime);
+        }
+
+        lastFrames = frames;
+        lastTime = now;
+
+        text.clear();
+        for ( int i = 0; i < NumPaintSections; ++i )
+        {
+            const auto& histogram = profiler.getHistogram(static_cast<PaintSection>(i));
+
+            text << juce::String(getPaintSectionName(static_cast<PaintSection>(i))).paddedRight(' ', 20)
+                 << "p50 " << juce::String(histogram.getPercentile(0.5), 1).paddedLeft(' ', 7)
+                 << "  p99 " << juce::String(histogram.getPercentile(0.99), 1).paddedLeft(' ', 7) << " us\n";
+        }
+
+        text << "this editor's response view:\n"
+             << "  " << juce::String(paintsPerSecond, 1) << " paints/s, "
+             << juce::String(skippedPerSecond, 1) << " refreshes/s with nothing new";
+
+        repaint();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        g.fillAll(juce::Colours::black);
+        g.setColour(juce::Colours::darkgrey);
+        g.drawRect(getLocalBounds());
+
+        g.setColour(juce::Colours::lightgrey);
+        g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 11.f, juce::Font::plain));
+        g.drawMultiLineText(message.isEmpty() ? text : text + "\n" + message, 6, 14, getWidth() - 12);
+    }
+
+    // fits the text timerCallback() builds and a message of up to two lines
+    static int getPreferredHeight() { return (NumPaintSections + 4) * 13 + 8; }
+private:
+    juce::String text, message;
+    ResponseViewFrames lastFrames;
+    double lastTime = 0.0;
+    double paintsPerSecond = 0.0, skippedPerSecond = 0.0;
+};
+
+#define SIMPLEEQ_PROFILE_PAINT(section) const PaintProfiler::ScopedTimer JUCE_JOIN_MACRO(paintProfilerTimer, __LINE__) (section)
+
+#else
+
+#define SIMPLEEQ_PROFILE_PAINT(section)
+
+#endif
@@ -1,850 +1,1707 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-void LookAndFeel::drawRotarySlider(juce::Graphics & g,
-                                   int x,
-                                   int y,
-                                   int width,
-                                   int height,
-                                   float sliderPosProportional,
-                                   float rotaryStartAngle,
-                                   float rotaryEndAngle,
-                                   juce::Slider & slider)
-{
-    using namespace juce;
-    
-    auto bounds = Rectangle<float>(x, y, width, height);
-    
-    //change color when enabled/disabled
-    auto enabled = slider.isEnabled();
-    
-    // slider circles
-    g.setColour(enabled ? Colour(97u, 18u, 167u) : Colours::darkgrey);
-    g.fillEllipse(bounds);
-    
-    g.setColour(enabled ? Colour(255u, 154u, 1u) : Colours::grey);
-    g.drawEllipse(bounds, 1.f);
-    
-    // cast rotary slider
-    if(auto * rswl = dynamic_cast<RotarySliderWithLabels*>(&slider))
-    {
-        auto center = bounds.getCentre();
-        
-        Path p;
-        
-        Rectangle<float> r;
-        r.setLeft(center.getX() -2);
-        r.setRight(center.getX() + 2);
-        r.setTop(bounds.getY());
-        // center - text height to get the top
-        r.setBottom(center.getY() - rswl->getTextHeight() * 1.5);
-        
-        p.addRoundedRectangle(r, 2.f);
-        
-        // ensure that start angle < end angle
-        jassert(rotaryStartAngle < rotaryEndAngle);
-        
-        // map slider's normalized value to radians
-        auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
-        
-        p.applyTransform(AffineTransform().rotated(sliderAngRad, center.getX(), center.getY()));
-        
-        g.fillPath(p);
-        
-        // bounding box for text in center of slider
-        g.setFont(rswl->getTextHeight());
-        auto text = rswl->getDisplayString();
-        auto strWidth = g.getCurrentFont().getStringWidth(text);
-        
-        r.setSize(strWidth + 4, rswl->getTextHeight() + 2);
-        r.setCentre(bounds.getCentre());
-        
-        g.setColour(enabled ? Colours::black : Colours::darkgrey);
-        g.fillRect(r);
-        
-        // paint text
-        g.setColour(enabled ? Colours::white : Colours::lightgrey);
-        g.drawFittedText(text, r.toNearestInt(), juce::Justification::centred, 1);
-    }
-}
-
-// power button graphic
-void LookAndFeel::drawToggleButton(juce::Graphics &g,
-                                                   juce::ToggleButton &toggleButton,
-                                                   bool shouldDrawButtonAsHighlighted,
-                                                   bool shouldDrawButtonAsDown)
-{
-    using namespace juce;
-    
-    // if you can cast toggleButton to power button type, draw powerbutton
-    if ( auto* pb = dynamic_cast<PowerButton*>(&toggleButton) )
-    {
-        Path powerButton;
-        
-        // rectangle for button shape
-        auto bounds = toggleButton.getLocalBounds();
-        auto size = jmin(bounds.getWidth(), bounds.getHeight()) - 6;
-        auto r = bounds.withSizeKeepingCentre(size, size).toFloat();
-        
-        // angles for top of gap of arc
-        float ang = 25.f;
-        
-        size -= 7;
-        
-        // powerbutton arc
-        powerButton.addCentredArc(r.getCentreX(),
-                                  r.getCentreY(),
-                                  size * 0.5,
-                                  size * 0.5,
-                                  0.f,
-                                  degreesToRadians(ang),
-                                  degreesToRadians(360.f - ang), true);
-        
-        // powerbutton vertical line
-        powerButton.startNewSubPath(r.getCentreX(), r.getY());
-        powerButton.lineTo(r.getCentre());
-        
-        PathStrokeType pst(2.f, PathStrokeType::JointStyle::curved);
-        
-        // gray for button on/ bypassed, green for off/ not bypassed
-        auto color = toggleButton.getToggleState() ? Colours::dimgrey : Colour(0u, 172u, 1u);
-        
-        g.setColour(color);
-        g.strokePath(powerButton, pst);
-        g.drawEllipse(r, 2);
-    }
-    
-    // analyzer button
-    else if ( auto* analyzerButton = dynamic_cast<AnalyzerButton*>(&toggleButton) )
-    {
-        auto color = toggleButton.getToggleState() ? Colour(0u, 172u, 1u) : Colours::dimgrey;
-        
-        g.setColour(color);
-        
-        auto bounds = toggleButton.getLocalBounds();
-        g.drawRect(bounds);
-        
-        g.strokePath(analyzerButton->randomPath, PathStrokeType(1.f));
-    }
-}
-//  ==============================================================================
-void RotarySliderWithLabels::paint(juce::Graphics &g)
-{
-    using namespace juce;
-    
-    // 7:30
-    auto startAng = degreesToRadians(180.f + 45.f);
-    // 4:30
-    auto endAng = degreesToRadians(180.f - 45.f) + MathConstants<float>::twoPi;
-    
-    auto range = getRange();
-    
-    auto sliderBounds = getSliderBounds();
-    
-    // slider bounding boxes
-//    g.setColour(Colours::red);
-//    g.drawRect(getLocalBounds());
-//    g.setColour(Colours::yellow);
-//    g.drawRect(sliderBounds);
-    
-    getLookAndFeel().drawRotarySlider(g,
-                                      sliderBounds.getX(),
-                                      sliderBounds.getY(),
-                                      sliderBounds.getWidth(),
-                                      sliderBounds.getHeight(),
-                                      jmap(getValue(), range.getStart(), range.getEnd(), 0.0, 1.0), // turn slider values to normalized value
-                                      startAng,
-                                      endAng,
-                                      *this);
-    
-    // get center and radius of slider bounds
-    auto center = sliderBounds.toFloat().getCentre();
-    auto radius = sliderBounds.getWidth() * 0.5f;
-    
-    g.setColour(Colour(0u, 182u, 1u));
-    g.setFont(getTextHeight());
-    
-    auto numChoices = labels.size();
-    for (int i = 0; i < numChoices; ++i)
-    {
-        auto pos = labels[i].pos;
-        jassert(0.f <= pos);
-        jassert(pos <= 1.f);
-        
-        auto ang = jmap(pos, 0.f, 1.f, startAng, endAng);
-        
-        // find center point of box using angle and gets point outside slider.
-        auto c = center.getPointOnCircumference(radius + getTextHeight() * 0.5f + 1, ang);
-        Rectangle<float> r;
-        auto str = labels[i].label;
-        r.setSize(g.getCurrentFont().getStringWidth(str), getTextHeight());
-        r.setCentre(c);
-        //shifts down from circle
-        r.setY(r.getY() + getTextHeight());
-        
-        g.drawFittedText(str, r.toNearestInt(), juce::Justification::centred, 1);
-    
-    }
-}
-
-
-juce::Rectangle<int> RotarySliderWithLabels::getSliderBounds() const
-{
-    auto bounds = getLocalBounds();
-    
-    // minimum dimension of bounding box
-    auto size = juce::jmin(bounds.getWidth(), bounds.getHeight());
-    
-    // shrink bounding box
-    size -= getTextHeight() * 2;
-    
-    //move slider bounds to the top, make it a square and put in center.
-    juce::Rectangle<int> r;
-    r.setSize(size, size);
-    r.setCentre(bounds.getCentreX(), 0);
-    r.setY(2);
-    
-    return r;
-    
-}
-
-juce::String RotarySliderWithLabels::getDisplayString() const
-{
-    // if parameter is a choice (filter) use that choice
-    if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(param))
-        return choiceParam->getCurrentChoiceName();
-    
-    // change hz value to khz if over 1k
-    juce::String str;
-    bool addK = false;
-    
-    //if(auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(param))
-    //{
-        float val = getValue();
-        
-        if(val > 999.f)
-        {
-            val /= 1000.f;
-            addK = true;
-        }
-        
-        // convert floating point to string to two decimal places
-        str = juce::String(val, (addK ? 2 : 0));
-    ///}
-
-    
-//    else
-//    {
-//        jassertfalse;
-//    }
-    
-//     suffix handling
-    if (suffix.isNotEmpty())
-    {
-        str << " ";
-        if (addK)
-            str << "k";
-        str << suffix;
-    }
-//
-    return str;
-}
-
-
-//  ==============================================================================
-ResponseCurveComponent::ResponseCurveComponent(SimpleEQAudioProcessor& p)
-: audioProcessor(p),
-//leftChannelFifo(&audioProcessor.leftChannelFifo)
-leftPathProducer(audioProcessor.leftChannelFifo),
-rightPathProducer(audioProcessor.rightChannelFifo)
-{
-    const auto& params = audioProcessor.getParameters();
-    for (auto param : params)
-    {
-        param->addListener(this);
-    }
-    
-    updateChain();
-    
-    startTimerHz(60);
-}
-
-ResponseCurveComponent::~ResponseCurveComponent()
-{
-    const auto& params = audioProcessor.getParameters();
-    for (auto param : params)
-    {
-        param->removeListener(this);
-    }
-    
-}
-
-void ResponseCurveComponent::parameterValueChanged(int parameterIndex, float newValue)
-{
-    parametersChanged.set(true);
-}
-
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
-{
-    juce::AudioBuffer<float> tempIncomingBuffer;
-    
-    while ( leftChannelFifo->getNumCompleteBuffersAvailable() > 0 )
-    {
-        if ( leftChannelFifo->getAudioBuffer(tempIncomingBuffer) )
-        {
-            // send data to FFT data generator
-            // shift every thing in monobuffer forward by # of samples in tempIncomingBuffer
-            auto size = tempIncomingBuffer.getNumSamples();
-            
-            // shift data over
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, 0),     // copy everything from 0
-                                              monoBuffer.getReadPointer(0, size),   // copy read everything from index size
-                                              monoBuffer.getNumSamples() - size);
-            
-            // copy to data to the end
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                                              tempIncomingBuffer.getReadPointer(0, 0),
-                                              size);
-            
-            // sending monobuffers to generator
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, -48.f);
-        }
-    }
-    // while there are buffers to pull, we're going to send it to FFT data generator
-    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
-    
-    /*
-     48000 / 2048 = 23hz <- this is the bin width
-     */
-    const auto binWidth = sampleRate / (double)fftSize;
-    
-    /*
-     if there are FFT data buffers to pull
-        if we can pull a buffer
-            generate a path
-     */
-    while ( leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0 )
-    {
-        std::vector<float> fftData;
-        if (leftChannelFFTDataGenerator.getFFTData(fftData))
-        {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, -48.f);
-        }
-    }
-    
-    /*
-     while there are paths that can be pulled
-        pull as many as we can
-            display th emost recent path
-     */
-    while( pathProducer.getNumPathsAvailable() )
-    {
-        pathProducer.getPath(leftChannelFFTPath);
-    }
-    
-}
-
-void ResponseCurveComponent::timerCallback()
-{
-    if( shouldShowFFTAnalysis )
-    {
-        auto fftBounds = getAnalysisArea().toFloat();
-        auto sampleRate = audioProcessor.getSampleRate();
-        
-        leftPathProducer.process(fftBounds, sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
-    }
-
-    
-    if (parametersChanged.compareAndSetBool(false, true))
-    {
-        //update the monochain
-        updateChain();
-        //signal repaint
-       // repaint();
-    }
-    
-    repaint();
-    
-}
-
-void ResponseCurveComponent::updateChain()
-{
-    //update monochain
-    auto chainSettings = getChainSettings(audioProcessor.apvts);
-    
-    monoChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
-    monoChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
-    monoChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
-    
-    auto peakCoefficients = makePeakFilter(chainSettings, audioProcessor.getSampleRate());
-    updateCoefficients(monoChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
-    
-    auto lowCutCoefficients = makeLowCutFilter(chainSettings, audioProcessor.getSampleRate());
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, audioProcessor.getSampleRate());
-    
-    updateCutFilter(monoChain.get<ChainPositions::LowCut>(), lowCutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(monoChain.get<ChainPositions::HighCut>(), highCutCoefficients, chainSettings.highCutSlope);
-}
-
-void ResponseCurveComponent::paint (juce::Graphics& g)
-{
-    using namespace juce;
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (Colours::black);
-    
-    g.drawImage(background, getLocalBounds().toFloat());
-
-    // auto responseArea = getLocalBounds();
-    auto responseArea = getAnalysisArea();
-    
-    auto w = responseArea.getWidth();
-    
-    //individual chain elements
-    auto& lowcut = monoChain.get<ChainPositions::LowCut>();
-    auto& peak = monoChain.get<ChainPositions::Peak>();
-    auto& highcut = monoChain.get<ChainPositions::HighCut>();
-    
-    auto sampleRate = audioProcessor.getSampleRate();
-    
-    //stores magnitudes
-    std::vector<double> mags;
-    
-    mags.resize(w);
-    
-    // iterate through each pixel and compute magnitude at each frequency
-    for ( int i = 0; i < w; ++i)
-    {
-        double mag = 1.f;
-        
-        // map pixel to frequency. map normalized pixel to its frequency in the range of human hearing
-        auto freq = mapToLog10(double(i) / double(w), 20.0, 20000.0);
-        
-        // magnitude function
-        if (!monoChain.isBypassed<ChainPositions::Peak>())
-            mag *= peak.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        // if low cut processor chain is not bypassed, check if individual bands are bypassed
-        if ( !monoChain.isBypassed<ChainPositions::LowCut>() )
-        {
-            // magnitude function for each cut slope
-            if (!lowcut.isBypassed<0>())
-                mag *= lowcut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!lowcut.isBypassed<1>())
-                mag *= lowcut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!lowcut.isBypassed<2>())
-                mag *= lowcut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!lowcut.isBypassed<3>())
-                mag *= lowcut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        }
-        
-        if ( ! monoChain.isBypassed<ChainPositions::HighCut>() )
-        {
-            if (!highcut.isBypassed<0>())
-                mag *= highcut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!highcut.isBypassed<1>())
-                mag *= highcut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!highcut.isBypassed<2>())
-                mag *= highcut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!highcut.isBypassed<3>())
-                mag *= highcut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        }
-        // convert magnitude to decibels and store it
-        mags[i] = Decibels::gainToDecibels(mag);
-    }
-    
-    //  convert vector of magnitudes to a path
-    Path responseCurve;
-    
-    // max and min positions in the window
-    const double outputMin = responseArea.getBottom();
-    const double outputMax = responseArea.getY();
-    //map from source input
-    auto map = [outputMin, outputMax](double input)
-    {
-        return jmap(input, -24.0, 24.0, outputMin, outputMax);
-    };
-    
-    // new subpath with the first magnitude - left edge
-    responseCurve.startNewSubPath(responseArea.getX(), map (mags.front()));
-    
-    // lines for every other magnitude
-    for (size_t i = 1; i < mags.size(); ++i)
-    {
-        responseCurve.lineTo(responseArea.getX() + i, map(mags[i]));
-    }
-    
-    // if analyzer is enabled, draw paths
-    if ( shouldShowFFTAnalysis )
-    {
-        // makes sure FFT matches bounds of responseArea
-        auto leftChannelFFTPath = leftPathProducer.getPath();
-        leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), responseArea.getY()));
-        
-        g.setColour(Colours::skyblue);
-        g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
-        
-        auto rightChannelFFTPath = rightPathProducer.getPath();
-        rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), responseArea.getY()));
-        
-        g.setColour(Colours::lightyellow);
-        g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
-        
-    }
-    
-    g.setColour(Colours::orange);
-    g.drawRoundedRectangle(getRenderArea().toFloat(), 4.f, 1.f);
-    
-    g.setColour(Colours::white);
-    g.strokePath(responseCurve, PathStrokeType(2.f));
-}
-
-void ResponseCurveComponent::resized()
-{
-    using namespace juce;
-    //
-    background = Image(Image::PixelFormat::RGB, getWidth(), getHeight(), true);
-    
-    Graphics g(background);
-    
-    // array to loop thru to convert frequencies to window space and draw as vertical lines
-    Array<float> freqs
-    {
-        20, /*30, 40,*/ 50, 100,
-        200,/*300, 400,*/ 500, 1000,
-        2000, /*3000, 4000,*/ 5000, 10000,
-        20000
-    };
-    
-    // cache info about analysis area
-    auto renderArea = getAnalysisArea();
-    auto left = renderArea.getX();
-    auto right = renderArea.getRight();
-    auto top = renderArea.getY();
-    auto bottom = renderArea.getBottom();
-    auto width = renderArea.getWidth();
-    
-    // cache into an array
-    Array<float> xs;
-    for ( auto f : freqs )
-    {
-        auto normX = mapFromLog10(f, 20.f, 20000.f);
-        xs.add(left + width * normX);
-    }
-    
-    // set color to white and loop thru freqs and map from linear space to normalized position
-    g.setColour(Colours::dimgrey);
-    for (auto x : xs )
-    {
-
-        g.drawVerticalLine(x, top, bottom);
-    }
-    
-    // gain lines
-    Array<float> gain {
-        -24, -12, 0, 12, 24
-    };
-    
-    for (auto gDb : gain)
-    {
-        auto y = jmap(gDb, -24.f, 24.f, float(bottom), float(top));
-
-        // set middle line to green, dark grey for the rest
-        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::darkgrey );
-        g.drawHorizontalLine(y, left, right);
-    }
-    
-    // frequency labels
-    g.setColour(Colours::lightgrey);
-    const int fontHeight = 10;
-    g.setFont(fontHeight);
-    
-    // loop thru freqs and xs and draw text above the grid
-    for (int i = 0; i < freqs.size(); ++i)
-    {
-        auto f = freqs[i];
-        auto x = xs[i];
-        
-        // suffix handling
-        bool addK = false;
-        String str;
-        if( f > 999.f )
-        {
-            addK = true;
-            f /= 1000.f;
-        }
-        
-        str << f;
-        if( addK )
-            str << "k";
-        str<< "Hz";
-        
-        // rectangle around string
-        auto textWidth = g.getCurrentFont().getStringWidth(str);
-        
-        Rectangle<int> r;
-        r.setSize(textWidth, fontHeight);
-        r.setCentre(x, 6);
-        r.setY(1);
-        
-        g.drawFittedText(str, r, juce::Justification::centred, 1);
-    }
-    
-    // gain labels
-    for ( auto gDb : gain )
-    {
-        auto y = jmap(gDb, -24.f, 24.f, float(bottom), float(top));
-        
-        // string with gain value
-        String str;
-        if (gDb > 0)
-            str << "+";
-        str << gDb;
-        
-        auto textWidth = g.getCurrentFont().getStringWidth(str);
-        
-        Rectangle<int> r;
-        r.setSize(textWidth, fontHeight);
-        r.setX(getWidth() - textWidth);
-        r.setCentre(r.getCentreX(), y);
-        
-        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::lightgrey );
-        
-        g.drawFittedText(str, r, juce::Justification::centred, 1);
-        
-        // spectrum labels
-        str.clear();
-        str << (gDb - 24.f);
-        
-        r.setX(1);
-        textWidth = g.getCurrentFont().getStringWidth(str);
-        r.setSize(textWidth, fontHeight);
-        g.setColour(Colours::lightgrey);
-        g.drawFittedText(str, r, juce::Justification::centred, 1);
-    }
-}
-
-juce::Rectangle<int> ResponseCurveComponent::getRenderArea()
-{
-    auto bounds = getLocalBounds();
-    
-    bounds.removeFromTop(12);
-    bounds.removeFromBottom(2);
-    bounds.removeFromLeft(20);
-    bounds.removeFromRight(20);
-    
-    return bounds;
-}
-
-juce::Rectangle<int> ResponseCurveComponent::getAnalysisArea()
-{
-    auto bounds = getRenderArea();
-    bounds.removeFromTop(4);
-    bounds.removeFromBottom(4);
-    
-    return bounds;
-}
-//==============================================================================
-SimpleEQAudioProcessorEditor::SimpleEQAudioProcessorEditor (SimpleEQAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p),
-peakFreqSlider(*audioProcessor.apvts.getParameter("Peak Freq"), "Hz"),
-peakGainSlider(*audioProcessor.apvts.getParameter("Peak Gain"), "dB"),
-peakQualitySlider(*audioProcessor.apvts.getParameter("Peak Quality"), ""),
-lowCutFreqSlider(*audioProcessor.apvts.getParameter("LowCut Freq"), "Hz"),
-highCutFreqSlider(*audioProcessor.apvts.getParameter("HighCut Freq"), "Hz"),
-lowCutSlopeSlider(*audioProcessor.apvts.getParameter("LowCut Slope"), "dB/Oct"),
-highCutSlopeSlider(*audioProcessor.apvts.getParameter("HighCut Slope"), "dB/Oct"),
-
-responseCurveComponent(audioProcessor),
-peakFreqSliderAttachement(audioProcessor.apvts, "Peak Freq", peakFreqSlider),
-peakGainSliderAttachment(audioProcessor.apvts, "Peak Gain", peakGainSlider),
-peakQualitySliderAttachment(audioProcessor.apvts, "Peak Quality", peakQualitySlider),
-lowCutFreqSliderAttachment(audioProcessor.apvts, "LowCut Freq", lowCutFreqSlider),
-highCutFreqSliderAttachment(audioProcessor.apvts, "HighCut Freq", highCutFreqSlider),
-lowCutSlopeSliderAttachment(audioProcessor.apvts, "LowCut Slope", lowCutSlopeSlider),
-highCutSlopeSliderAttachment(audioProcessor.apvts, "HighCut Slope", highCutSlopeSlider),
-
-lowCutBypassButtonAttachment(audioProcessor.apvts, "LowCut Bypassed", lowCutBypassButton),
-peakBypassButtonAttachment(audioProcessor.apvts, "Peak Bypassed", peakBypassButton),
-highCutBypassButtonAttachment(audioProcessor.apvts, "HighCut Bypassed", highCutBypassButton),
-analyzerEnabledButtonAttachment(audioProcessor.apvts, "Analyzer Enabled", analyzerEnabledButton)
-{
-    // Make sure that before the constructor has finished, you've set the
-    // editor's size to whatever you need it to be.
-    
-    // min max values
-    peakFreqSlider.labels.add({0.f, "20Hz"});
-    peakFreqSlider.labels.add({1.f, "20kHz"});
-    
-    peakGainSlider.labels.add({0.f, "-24dB"});
-    peakGainSlider.labels.add({1.f, "+24dB"});
-    
-    peakQualitySlider.labels.add({0.f, "0.1"});
-    peakQualitySlider.labels.add({1.f, "10.0"});
-    
-    lowCutFreqSlider.labels.add({0.f, "20Hz"});
-    lowCutFreqSlider.labels.add({1.f, "20kHz"});
-    
-    highCutFreqSlider.labels.add({0.f, "20Hz"});
-    highCutFreqSlider.labels.add({1.f, "20kHz"});
-    
-    lowCutSlopeSlider.labels.add({0.f, "12"});
-    lowCutSlopeSlider.labels.add({1.f, "48"});
-    
-    highCutSlopeSlider.labels.add({0.f, "12"});
-    highCutSlopeSlider.labels.add({1.f, "48"});
-    
-    for ( auto* comp : getComps())
-    {
-        addAndMakeVisible(comp);
-    }
-    // get parameters and add a listener
-    peakBypassButton.setLookAndFeel(&lnf);
-    lowCutBypassButton.setLookAndFeel(&lnf);
-    highCutBypassButton.setLookAndFeel(&lnf);
-    analyzerEnabledButton.setLookAndFeel(&lnf);
-    
-    // on click lamdas to change enablement of sliders
-    // makes sure class(editor) is still in existence when using onclick lamda
-    auto safePtr = juce::Component::SafePointer<SimpleEQAudioProcessorEditor>(this);
-    peakBypassButton.onClick = [safePtr]()
-    {
-        if ( auto* comp = safePtr.getComponent() )
-        {
-            auto bypassed = comp->peakBypassButton.getToggleState();
-            
-            comp->peakFreqSlider.setEnabled( !bypassed );
-            comp->peakGainSlider.setEnabled( !bypassed );
-            comp->peakQualitySlider.setEnabled( !bypassed);
-        }
-    };
-    
-    lowCutBypassButton.onClick = [safePtr]()
-    {
-        if ( auto* comp = safePtr.getComponent() )
-        {
-            auto bypassed = comp->lowCutBypassButton.getToggleState();
-            
-            comp->lowCutFreqSlider.setEnabled( !bypassed );
-            comp->lowCutSlopeSlider.setEnabled( !bypassed );
-        }
-    };
-    
-    highCutBypassButton.onClick = [safePtr]()
-    {
-        if ( auto* comp = safePtr.getComponent() )
-        {
-            auto bypassed = comp->highCutBypassButton.getToggleState();
-            
-            comp->highCutFreqSlider.setEnabled( !bypassed );
-            comp->highCutSlopeSlider.setEnabled( !bypassed );
-        }
-    };
-    
-    analyzerEnabledButton.onClick = [safePtr]()
-    {
-        if ( auto* comp = safePtr.getComponent() )
-        {
-            auto enabled = comp->analyzerEnabledButton.getToggleState();
-            comp->responseCurveComponent.toggleAnalysisEnablement(enabled);
-        }
-    };
-    
-    setSize (600, 400);
-}
-
-SimpleEQAudioProcessorEditor::~SimpleEQAudioProcessorEditor()
-{
-    peakBypassButton.setLookAndFeel(nullptr);
-    lowCutBypassButton.setLookAndFeel(nullptr);
-    highCutBypassButton.setLookAndFeel(nullptr);
-    analyzerEnabledButton.setLookAndFeel(nullptr);
-}
-
-//==============================================================================
-void SimpleEQAudioProcessorEditor::paint (juce::Graphics& g)
-{
-    using namespace juce;
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (Colours::black);
-
-}
-
-
-
-
-void SimpleEQAudioProcessorEditor::resized()
-{
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
-    
-    auto bounds = getLocalBounds();
-    
-    //analyzer bypass button area
-    auto analyzerEnabledArea = bounds.removeFromTop(25);
-    analyzerEnabledArea.setWidth(100);
-    analyzerEnabledArea.setX(5);
-    analyzerEnabledArea.removeFromTop(2);
-    
-    analyzerEnabledButton.setBounds(analyzerEnabledArea);
-    
-    bounds.removeFromTop(5);
-    
-    // JUCE LIVE CONSTANT lets you adjust visuals while running
-    float hRatio = 25.f / 100.f; // JUCE_LIVE_CONSTANT(25) / 100.f;
-    //sets space aside for spectogram
-    auto responseArea = bounds.removeFromTop(bounds.getHeight() * hRatio);
-    
-    responseCurveComponent.setBounds(responseArea);
-    
-    // creates space between sliders and spectrum analyzer
-    bounds.removeFromTop(5);
-    
-    auto lowCutArea = bounds.removeFromLeft(bounds.getWidth() * .33);
-    //after taking 33% for the left side, there is 66% left, so take half of that for right side
-    auto highCutArea = bounds.removeFromRight(bounds.getWidth() * .5);
-    
-    lowCutBypassButton.setBounds(lowCutArea.removeFromTop(25));
-    lowCutFreqSlider.setBounds(lowCutArea.removeFromTop(bounds.getHeight() * 0.5));
-    lowCutSlopeSlider.setBounds(lowCutArea);
-    
-    highCutBypassButton.setBounds(highCutArea.removeFromTop(25));
-    highCutFreqSlider.setBounds(highCutArea.removeFromTop(bounds.getHeight() * 0.5));
-    highCutSlopeSlider.setBounds(highCutArea);
-    
-    //peak slider at top,
-    peakBypassButton.setBounds(bounds.removeFromTop(25));
-    peakFreqSlider.setBounds(bounds.removeFromTop(bounds.getHeight() * .33));
-    peakGainSlider.setBounds(bounds.removeFromTop(bounds.getHeight() * .5));
-    peakQualitySlider.setBounds(bounds);
-    
-    
-}
-
-std::vector<juce::Component*> SimpleEQAudioProcessorEditor::getComps()
-{
-    return
-    {
-        &peakFreqSlider,
-        &peakGainSlider,
-        &peakQualitySlider,
-        &lowCutFreqSlider,
-        &highCutFreqSlider,
-        &lowCutSlopeSlider,
-        &highCutSlopeSlider,
-        &responseCurveComponent,
-        
-        &lowCutBypassButton,
-        &highCutBypassButton,
-        &peakBypassButton,
-        &analyzerEnabledButton
-    };
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+void LookAndFeel::drawRotarySlider(juce::Graphics & g,
+                                   int x,
+                                   int y,
+                                   int width,
+                                   int height,
+                                   float sliderPosProportional,
+                                   float rotaryStartAngle,
+                                   float rotaryEndAngle,
+                                   juce::Slider & slider)
+{
+    SIMPLEEQ_PROFILE_PAINT(RotarySliderDrawing);
+    
+    using namespace juce;
+    
+    auto bounds = Rectangle<float>(x, y, width, height);
+    
+    //change color when enabled/disabled
+    auto enabled = slider.isEnabled();
+    
+    // slider circles
+    g.setColour(enabled ? Colour(97u, 18u, 167u) : Colours::darkgrey);
+    g.fillEllipse(bounds);
+    
+    g.setColour(enabled ? Colour(255u, 154u, 1u) : Colours::grey);
+    g.drawEllipse(bounds, 1.f);
+    
+    // cast rotary slider
+    if(auto * rswl = dynamic_cast<RotarySliderWithLabels*>(&slider))
+    {
+        auto center = bounds.getCentre();
+        
+        Path p;
+        
+        Rectangle<float> r;
+        r.setLeft(center.getX() -2);
+        r.setRight(center.getX() + 2);
+        r.setTop(bounds.getY());
+        // center - text height to get the top
+        r.setBottom(center.getY() - rswl->getTextHeight() * 1.5);
+        
+        p.addRoundedRectangle(r, 2.f);
+        
+        // ensure that start angle < end angle
+        jassert(rotaryStartAngle < rotaryEndAngle);
+        
+        // map slider's normalized value to radians
+        auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
+        
+        p.applyTransform(AffineTransform().rotated(sliderAngRad, center.getX(), center.getY()));
+        
+        g.fillPath(p);
+        
+        // bounding box for text in center of slider
+        g.setFont(rswl->getTextHeight());
+        auto text = rswl->getDisplayString();
+        auto strWidth = g.getCurrentFont().getStringWidth(text);
+        
+        r.setSize(strWidth + 4, rswl->getTextHeight() + 2);
+        r.setCentre(bounds.getCentre());
+        
+        g.setColour(enabled ? Colours::black : Colours::darkgrey);
+        g.fillRect(r);
+        
+        // paint text
+        g.setColour(enabled ? Colours::white : Colours::lightgrey);
+        g.drawFittedText(text, r.toNearestInt(), juce::Justification::centred, 1);
+    }
+}
+
+// power button graphic
+void LookAndFeel::drawToggleButton(juce::Graphics &g,
+                                                   juce::ToggleButton &toggleButton,
+                                                   bool shouldDrawButtonAsHighlighted,
+                                                   bool shouldDrawButtonAsDown)
+{
+    SIMPLEEQ_PROFILE_PAINT(ToggleButtonDrawing);
+    
+    using namespace juce;
+    
+    // if you can cast toggleButton to power button type, draw powerbutton
+    if ( auto* pb = dynamic_cast<PowerButton*>(&toggleButton) )
+    {
+        Path powerButton;
+        
+        // rectangle for button shape
+        auto bounds = toggleButton.getLocalBounds();
+        auto size = jmin(bounds.getWidth(), bounds.getHeight()) - 6;
+        auto r = bounds.withSizeKeepingCentre(size, size).toFloat();
+        
+        // angles for top of gap of arc
+        float ang = 25.f;
+        
+        size -= 7;
+        
+        // powerbutton arc
+        powerButton.addCentredArc(r.getCentreX(),
+                                  r.getCentreY(),
+                                  size * 0.5,
+                                  size * 0.5,
+                                  0.f,
+                                  degreesToRadians(ang),
+                                  degreesToRadians(360.f - ang), true);
+        
+        // powerbutton vertical line
+        powerButton.startNewSubPath(r.getCentreX(), r.getY());
+        powerButton.lineTo(r.getCentre());
+        
+        PathStrokeType pst(2.f, PathStrokeType::JointStyle::curved);
+        
+        // gray for button on/ bypassed, green for off/ not bypassed
+        auto color = toggleButton.getToggleState() ? Colours::dimgrey : Colour(0u, 172u, 1u);
+        
+        g.setColour(color);
+        g.strokePath(powerButton, pst);
+        g.drawEllipse(r, 2);
+    }
+    
+    // analyzer button
+    else if ( auto* analyzerButton = dynamic_cast<AnalyzerButton*>(&toggleButton) )
+    {
+        auto color = toggleButton.getToggleState() ? Colour(0u, 172u, 1u) : Colours::dimgrey;
+        
+        g.setColour(color);
+        
+        auto bounds = toggleButton.getLocalBounds();
+        g.drawRect(bounds);
+        
+        g.strokePath(analyzerButton->randomPath, PathStrokeType(1.f));
+    }
+}
+//  ==============================================================================
+void RotarySliderWithLabels::paint(juce::Graphics &g)
+{
+    SIMPLEEQ_PROFILE_PAINT(RotarySliderPaint);
+    
+    using namespace juce;
+    
+    // 7:30
+    auto startAng = degreesToRadians(180.f + 45.f);
+    // 4:30
+    auto endAng = degreesToRadians(180.f - 45.f) + MathConstants<float>::twoPi;
+    
+    auto range = getRange();
+    
+    auto sliderBounds = getSliderBounds();
+    
+    // slider bounding boxes
+//    g.setColour(Colours::red);
+//    g.drawRect(getLocalBounds());
+//    g.setColour(Colours::yellow);
+//    g.drawRect(sliderBounds);
+    
+    getLookAndFeel().drawRotarySlider(g,
+                                      sliderBounds.getX(),
+                                      sliderBounds.getY(),
+                                      sliderBounds.getWidth(),
+                                      sliderBounds.getHeight(),
+                                      jmap(getValue(), range.getStart(), range.getEnd(), 0.0, 1.0), // turn slider values to normalized value
+                                      startAng,
+                                      endAng,
+                                      *this);
+    
+    // get center and radius of slider bounds
+    auto center = sliderBounds.toFloat().getCentre();
+    auto radius = sliderBounds.getWidth() * 0.5f;
+    
+    g.setColour(Colour(0u, 182u, 1u));
+    g.setFont(getTextHeight());
+    
+    auto numChoices = labels.size();
+    for (int i = 0; i < numChoices; ++i)
+    {
+        auto pos = labels[i].pos;
+        jassert(0.f <= pos);
+        jassert(pos <= 1.f);
+        
+        auto ang = jmap(pos, 0.f, 1.f, startAng, endAng);
+        
+        // find center point of box using angle and gets point outside slider.
+        auto c = center.getPointOnCircumference(radius + getTextHeight() * 0.5f + 1, ang);
+        Rectangle<float> r;
+        auto str = labels[i].label;
+        r.setSize(g.getCurrentFont().getStringWidth(str), getTextHeight());
+        r.setCentre(c);
+        //shifts down from circle
+        r.setY(r.getY() + getTextHeight());
+        
+        g.drawFittedText(str, r.toNearestInt(), juce::Justification::centred, 1);
+    
+    }
+}
+
+
+juce::Rectangle<int> RotarySliderWithLabels::getSliderBounds() const
+{
+    auto bounds = getLocalBounds();
+    
+    // minimum dimension of bounding box
+    auto size = juce::jmin(bounds.getWidth(), bounds.getHeight());
+    
+    // shrink bounding box
+    size -= getTextHeight() * 2;
+    
+    //move slider bounds to the top, make it a square and put in center.
+    juce::Rectangle<int> r;
+    r.setSize(size, size);
+    r.setCentre(bounds.getCentreX(), 0);
+    r.setY(2);
+    
+    return r;
+    
+}
+
+juce::String RotarySliderWithLabels::getDisplayString() const
+{
+    // if parameter is a choice (filter) use that choice
+    if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(param))
+        return choiceParam->getCurrentChoiceName();
+    
+    // change hz value to khz if over 1k
+    juce::String str;
+    bool addK = false;
+    
+    //if(auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(param))
+    //{
+        float val = getValue();
+        
+        if(val > 999.f)
+        {
+            val /= 1000.f;
+            addK = true;
+        }
+        
+        // convert floating point to string to two decimal places
+        str = juce::String(val, (addK ? 2 : 0));
+    ///}
+
+    
+//    else
+//    {
+//        jassertfalse;
+//    }
+    
+//     suffix handling
+    if (suffix.isNotEmpty())
+    {
+        str << " ";
+        if (addK)
+            str << "k";
+        str << suffix;
+    }
+//
+    return str;
+}
+
+
+//  ==============================================================================
+ResponseCurveComponent::ResponseCurveComponent(SimpleEQAudioProcessor& p)
+: audioProcessor(p)
+{
+    for (auto index : chainParameters)
+    {
+        audioProcessor.apvts.getParameter(getParameterID(index))->addListener(this);
+    }
+    
+    if ( ! audioProcessor.getChainSnapshot(chainSnapshot, chainSnapshotVersion) )
+        designChainHere();
+    
+    /*
+     the analyzer is made on the first frame it's shown, see getAnalyzer(). the button's
+     onClick only hears about changes, so a session saved with it off starts off here too
+     */
+    shouldShowFFTAnalysis = audioProcessor.apvts.getRawParameterValue(getParameterID(AnalyzerEnabledParameter))->load() > 0.5f;
+}
+
+ResponseCurveComponent::~ResponseCurveComponent()
+{
+    for (auto index : chainParameters)
+    {
+        audioProcessor.apvts.getParameter(getParameterID(index))->removeListener(this);
+    }
+    
+    if ( analyzer == nullptr )
+        return;
+    
+    // the job reads the path producer and the processor's fifos, so it has to be gone first.
+    // no timeout: a round only drains what the fifos hold, and giving up would free it under a pool thread
+    analysisThreadPool->pool.removeJob(&analyzer->job, true, -1);
+    
+    if ( isMeasuringInput )
+        audioProcessor.stopMeasuring();
+    
+    audioProcessor.detachAnalyzer();
+}
+
+ResponseCurveComponent::Analyzer& ResponseCurveComponent::getAnalyzer()
+{
+    if ( analyzer == nullptr )
+    {
+        analyzer = std::make_unique<Analyzer>(audioProcessor);
+        
+        // allocates the processor's analyzer fifos if we're the first editor
+        audioProcessor.attachAnalyzer();
+        applyAnalyzerSettings();
+    }
+    
+    return *analyzer;
+}
+
+void ResponseCurveComponent::applyAnalyzerSettings()
+{
+    if ( analyzer == nullptr )
+        return;
+    
+    auto& pathProducer = analyzer->pathProducer;
+    pathProducer.setMidSide(analyzerSettings.midSide);
+    pathProducer.setFFTOrder(analyzerSettings.order);
+    pathProducer.setWindow(analyzerSettings.window);
+    pathProducer.setSmoothing(analyzerSettings.smoothing);
+    pathProducer.setFrameMerge(analyzerSettings.frameMerge);
+    pathProducer.setMeasuring(analyzerSettings.measuring);
+    
+    // the processor only copies its input for us while we measure
+    if ( analyzerSettings.measuring != isMeasuringInput )
+    {
+        isMeasuringInput = analyzerSettings.measuring;
+        
+        if ( isMeasuringInput )
+            audioProcessor.startMeasuring();
+        else
+            audioProcessor.stopMeasuring();
+    }
+}
+
+void ResponseCurveComponent::parameterValueChanged(int parameterIndex, float newValue)
+{
+    parametersChanged.set(true);
+}
+
+bool SpectrumCaptureWriter::start(const juce::File& directory, juce::ThreadPool& pool)
+{
+    if ( isCapturing() )
+        return true;
+    
+    if ( ! directory.createDirectory() )
+        return false;
+    
+    captureDirectory = directory;
+    captureName = "SimpleEQ " + juce::Time::getCurrentTime().formatted("%Y-%m-%d %H-%M-%S");
+    numFilesCreated = 0;
+    numDroppedFrames.store(0);
+    failed.store(false);
+    startTimeMs = juce::Time::getMillisecondCounterHiRes();
+    
+    // the first file is made on the pool like every other one, frames before it's ready are dropped
+    filePool = &pool;
+    capturing.store(true);
+    filePool->addJob(&fileJob, false);
+    return true;
+}
+
+void SpectrumCaptureWriter::stop()
+{
+    capturing.store(false);
+    
+    // no timeout: the job is ours, and giving up would leave it running on files we're about to finish
+    if ( filePool != nullptr )
+        filePool->removeJob(&fileJob, true, -1);
+    
+    std::unique_ptr<CaptureFile> lastFile, unusedFile, finishedFile;
+    {
+        const juce::SpinLock::ScopedLockType lock(fileLock);
+        lastFile = std::move(current);
+        unusedFile = std::move(spare);
+        finishedFile = std::move(finished);
+    }
+    
+    finishFile(std::move(finishedFile));
+    finishFile(std::move(lastFile));
+    finishFile(std::move(unusedFile));
+}
+
+void SpectrumCaptureWriter::service()
+{
+    if ( ! isCapturing() || failed.load() || filePool == nullptr || filePool->contains(&fileJob) )
+        return;
+    
+    bool needsJob = false;
+    {
+        const juce::SpinLock::ScopedLockType lock(fileLock);
+        needsJob = finished != nullptr || spare == nullptr;
+    }
+    
+    if ( needsJob )
+        filePool->addJob(&fileJob, false);
+}
+
+// on the pool. the disk work happens out here, the writer only ever sees a ready mapped file
+void SpectrumCaptureWriter::updateFiles()
+{
+    std::unique_ptr<CaptureFile> finishedFile;
+    bool needsSpare = false;
+    {
+        const juce::SpinLock::ScopedLockType lock(fileLock);
+        finishedFile = std::move(finished);
+        needsSpare = spare == nullptr;
+    }
+    
+    finishFile(std::move(finishedFile));
+    
+    if ( ! needsSpare || ! isCapturing() )
+        return;
+    
+    auto newFile = createFile();
+    
+    if ( newFile == nullptr )
+    {
+        failed.store(true);
+        return;
+    }
+    
+    const juce::SpinLock::ScopedLockType lock(fileLock);
+    spare = std::move(newFile);
+}
+
+void SpectrumCaptureWriter::write(const Settings& settings, Spectrum spectrum, const FFTFrame& frame, float negativeInfinity)
+{
+    using namespace SpectrumCaptureFormat;
+    
+    if ( ! isCapturing() )
+        return;
+    
+    const juce::SpinLock::ScopedTryLockType lock(fileLock);
+    if ( ! lock.isLocked() )
+    {
+        ++numDroppedFrames;
+        return;
+    }
+    
+    const auto numBins = (uint32_t) frame.getNumBins();
+    
+    bool needsNewFile = current == nullptr
+                        || ! (settings == currentSettings)
+                        || numBins != current->header.numBins
+                        || current->header.frameCount >= current->header.capacity;
+    
+    if ( needsNewFile )
+    {
+        // no spare yet, or the last full file hasn't been closed
+        if ( spare == nullptr || (current != nullptr && finished != nullptr) )
+        {
+            ++numDroppedFrames;
+            return;
+        }
+        
+        if ( current != nullptr )
+            finished = std::move(current);
+        
+        current = std::move(spare);
+        currentSettings = settings;
+        
+        Header header {};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.headerSize = headerSize;
+        header.sampleRate = settings.sampleRate;
+        header.fftSize = (uint32_t) settings.fftSize;
+        header.window = (uint32_t) settings.window;
+        header.numBins = numBins;
+        header.frameSize = getFrameSize(numBins);
+        header.capacity = (uint32_t) ((fileSizeInBytes - (juce::int64) headerSize) / header.frameSize);
+        header.negativeInfinity = negativeInfinity;
+        header.frameCount = 0;
+        
+        current->header = header;
+        writeHeader(current->getData(), header);
+    }
+    
+    auto& header = current->header;
+    auto* destination = current->getData() + header.headerSize + header.frameCount * header.frameSize;
+    
+    FrameHeader frameHeader {};
+    frameHeader.timestamp = (juce::Time::getMillisecondCounterHiRes() - startTimeMs) / 1000.0;
+    frameHeader.spectrum = (uint32_t) spectrum;
+    
+    writeFrame(destination, frameHeader, frame.getCodes(), numBins);
+    
+    // only counted once the frame is complete, so a reader never sees half of one
+    ++header.frameCount;
+    writeValue(current->getData() + frameCountOffset, header.frameCount);
+}
+
+std::unique_ptr<SpectrumCaptureWriter::CaptureFile> SpectrumCaptureWriter::createFile()
+{
+    auto captureFile = std::make_unique<CaptureFile>();
+    
+    {
+        /*
+         names only have one second resolution, so two editors can start capturing under the same one.
+         picking a name and creating the file happen under one lock for the whole process, so every
+         writer gets a file of its own, and never opens (and later truncates or deletes) someone else's
+         */
+        static juce::CriticalSection namingLock;
+        const juce::ScopedLock lock(namingLock);
+        
+        captureFile->file = captureDirectory.getNonexistentChildFile(captureName + " " + juce::String(++numFilesCreated).paddedLeft('0', 3),
+                                                                     ".seqspec",
+                                                                     false);
+        
+        if ( captureFile->file.exists() )
+            return nullptr;
+        
+        // sized up front, most filesystems don't write out the gap
+        juce::FileOutputStream out(captureFile->file);
+        if ( ! out.openedOk() || ! out.setPosition(fileSizeInBytes - 1) || ! out.writeByte(0) )
+            return nullptr;
+    }
+    
+    captureFile->map = std::make_unique<juce::MemoryMappedFile>(captureFile->file, juce::MemoryMappedFile::readWrite);
+    
+    if ( captureFile->map->getData() == nullptr || (juce::int64) captureFile->map->getSize() < fileSizeInBytes )
+    {
+        captureFile->map.reset();
+        captureFile->file.deleteFile();
+        return nullptr;
+    }
+    
+    return captureFile;
+}
+
+// unmaps the file and cuts it down to the frames that were written, or deletes it if there are none
+void SpectrumCaptureWriter::finishFile(std::unique_ptr<CaptureFile> captureFile)
+{
+    if ( captureFile == nullptr )
+        return;
+    
+    const auto header = captureFile->header;
+    captureFile->map.reset();
+    
+    if ( header.frameCount == 0 )
+    {
+        captureFile->file.deleteFile();
+        return;
+    }
+    
+    juce::FileOutputStream out(captureFile->file);
+    if ( out.openedOk() && out.setPosition((juce::int64) (header.headerSize + header.frameCount * header.frameSize)) )
+        out.truncate();
+}
+
+void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate, int fftBudget, int spectrogramRows)
+{
+    applyRequestedSettings(sampleRate);
+    
+    const bool shouldShowMidSide = midSide.load();
+    fftDataGenerator.setFrameMerge(frameMerge.load());
+    fftDataGenerator.setSmoothing(smoothing.load());
+    
+    int numFFTs = 0;
+    bool skippedFFT = false;
+    bool shouldMeasure = false;
+    
+    {
+        // the processor is preparing or releasing the fifos, they're read again next tick
+        const juce::ScopedTryLock fifoLock(fifoReadLock);
+        
+        if ( ! fifoLock.isLocked() )
+            return;
+        
+        // the processor only feeds the input fifo while someone measures, see SimpleEQAudioProcessor::startMeasuring()
+        const bool hasInput = inputChannelFifo->isPrepared();
+        shouldMeasure = measuring.load() && hasInput;
+        
+        // the input analysis buffer holds nothing useful until a whole window of input has arrived
+        if ( hasInput && ! hadInput )
+            inputSamplesUntilValid = inputAnalysisBuffer.getCapacity();
+        
+        hadInput = hasInput;
+        
+        /*
+         all fifos are filled by the same processBlock, so their blocks line up.
+         while the input fifo is fed it's drained even when nothing is measured, or it would fall out of step
+         */
+        while ( leftChannelFifo->getNumCompleteBuffersAvailable() > 0
+               && rightChannelFifo->getNumCompleteBuffersAvailable() > 0
+               && ( ! hasInput || inputChannelFifo->getNumCompleteBuffersAvailable() > 0 ) )
+        {
+            if ( leftChannelFifo->getAudioBuffer(leftIncomingBuffer)
+                && rightChannelFifo->getAudioBuffer(rightIncomingBuffer)
+                && ( ! hasInput || inputChannelFifo->getAudioBuffer(inputIncomingBuffer) ) )
+            {
+                jassert( leftIncomingBuffer.getNumSamples() == rightIncomingBuffer.getNumSamples() );
+                
+                // write the blocks into the analysis buffers, stopping every hopSize samples to run an FFT
+                auto* leftSamples = leftIncomingBuffer.getReadPointer(0);
+                auto* rightSamples = rightIncomingBuffer.getReadPointer(0);
+                auto size = juce::jmin(leftIncomingBuffer.getNumSamples(),
+                                       rightIncomingBuffer.getNumSamples());
+                
+                const float* inputSamples = nullptr;
+                
+                if ( hasInput )
+                {
+                    jassert( leftIncomingBuffer.getNumSamples() == inputIncomingBuffer.getNumSamples() );
+                    inputSamples = inputIncomingBuffer.getReadPointer(0);
+                    size = juce::jmin(size, inputIncomingBuffer.getNumSamples());
+                }
+                
+                // the multi-resolution bank runs its own (decimated) hops
+                if ( useMultiResolution )
+                    multiResolutionAnalyzer.process(leftSamples, rightSamples, size, shouldShowMidSide, -48.f);
+                
+                // the analysis buffers are filled either way, so switching back can show the next hop straight away
+                while ( size > 0 )
+                {
+                    auto numToWrite = juce::jmin(size, samplesUntilNextFFT);
+                    leftAnalysisBuffer.push(leftSamples, numToWrite);
+                    rightAnalysisBuffer.push(rightSamples, numToWrite);
+                    
+                    if ( inputSamples != nullptr )
+                    {
+                        inputAnalysisBuffer.push(inputSamples, numToWrite);
+                        inputSamples += numToWrite;
+                        inputSamplesUntilValid = juce::jmax(0, inputSamplesUntilValid - numToWrite);
+                    }
+                    
+                    leftSamples += numToWrite;
+                    rightSamples += numToWrite;
+                    size -= numToWrite;
+                    samplesUntilNextFFT -= numToWrite;
+                    
+                    if ( samplesUntilNextFFT == 0 )
+                    {
+                        // sending the analysis windows to the generator, unless this tick's budget is spent
+                        if ( ! useMultiResolution || shouldMeasure )
+                        {
+                            if ( numFFTs < fftBudget )
+                            {
+                                runFFT(shouldShowMidSide, shouldMeasure && inputSamplesUntilValid == 0);
+                                ++numFFTs;
+                            }
+                            else
+                            {
+                                skippedFFT = true;
+                            }
+                        }
+                        
+                        samplesUntilNextFFT = hopSize;
+                    }
+                }
+            }
+        }
+    }
+    
+    // over budget: the newest window is the one worth showing
+    if ( skippedFFT )
+        runFFT(shouldShowMidSide, shouldMeasure && inputSamplesUntilValid == 0);
+    
+    // while there are buffers to pull, we're going to send it to FFT data generator
+    const auto fftSize = fftDataGenerator.getFFTSize();
+    
+    /*
+     48000 / 2048 = 23hz <- this is the bin width
+     */
+    const auto binWidth = sampleRate / (double)fftSize;
+    
+    bool gotPath[NumSpectra] = {};
+    bool gotSpectrogramColumn = false;
+    
+    // the spectrogram follows the first trace that's drawn
+    const auto spectrogramSpectrum = shouldShowMidSide ? MidSpectrum : LeftSpectrum;
+    
+    /*
+     every frame since the last tick has been merged into one per spectrum,
+     so build exactly one path for each spectrum that got data
+     */
+    for ( int i = 0; i < NumSpectra; ++i )
+    {
+        auto spectrum = static_cast<Spectrum>(i);
+        
+        if ( useMultiResolution )
+        {
+            if ( multiResolutionAnalyzer.getFFTData(spectrum, fftFrame, -48.f) )
+            {
+                const auto& binFrequencies = multiResolutionAnalyzer.getBinFrequencies();
+                const auto layoutId = multiResolutionAnalyzer.getLayoutId();
+                
+                gotPath[i] = pathGenerators[i].generatePath(fftFrame, fftBounds, binFrequencies, layoutId, workerPaths[i]);
+                
+                if ( spectrum == spectrogramSpectrum && spectrogramRows > 0 )
+                    gotSpectrogramColumn = spectrogramColumnGenerator.generateColumn(fftFrame, spectrogramRows, binFrequencies, layoutId, workerSpectrogramColumn);
+            }
+        }
+        else if ( fftDataGenerator.getFFTData(spectrum, fftFrame, -48.f) )
+        {
+            gotPath[i] = pathGenerators[i].generatePath(fftFrame, fftBounds, fftSize, binWidth, workerPaths[i]);
+            
+            // the capture format has evenly spaced bins, so the multi-resolution spectrum isn't recorded
+            captureWriter.write({ sampleRate, fftSize, fftDataGenerator.getWindow() }, spectrum, fftFrame, -48.f);
+            
+            if ( spectrum == spectrogramSpectrum && spectrogramRows > 0 )
+                gotSpectrogramColumn = spectrogramColumnGenerator.generateColumn(fftFrame, spectrogramRows, fftSize, binWidth, workerSpectrogramColumn);
+        }
+    }
+    
+    bool gotMeasurementPath[NumMeasurementTraces] = {};
+    
+    // the measurement always comes from the single FFT, whatever the analyzer shows
+    if ( shouldMeasure )
+    {
+        for ( int i = 0; i < NumMeasurementTraces; ++i )
+        {
+            if ( transferFunctionAnalyzer.getFFTData(static_cast<MeasurementTrace>(i), fftFrame, -48.f) )
+                gotMeasurementPath[i] = measurementPathGenerators[i].generatePath(fftFrame, fftBounds, fftSize, binWidth, workerMeasurementPaths[i]);
+        }
+    }
+    
+    const juce::SpinLock::ScopedLockType lock(pathLock);
+    for ( int i = 0; i < NumSpectra; ++i )
+    {
+        if ( gotPath[i] )
+        {
+            paths[i].swapWithPath(workerPaths[i]);
+            pathIsNew[i] = true;
+        }
+    }
+    
+    if ( gotSpectrogramColumn )
+    {
+        spectrogramColumn.swap(workerSpectrogramColumn);
+        spectrogramColumnIsNew = true;
+    }
+    
+    for ( int i = 0; i < NumMeasurementTraces; ++i )
+    {
+        if ( gotMeasurementPath[i] )
+        {
+            measurementPaths[i].swapWithPath(workerMeasurementPaths[i]);
+            measurementPathIsNew[i] = true;
+        }
+    }
+}
+
+void PathProducer::applyRequestedSettings(double sampleRate)
+{
+    auto newOrder = requestedOrder.load();
+    
+    useMultiResolution = newOrder == orderMultiResolution;
+    if ( useMultiResolution )
+    {
+        multiResolutionAnalyzer.setSampleRate(sampleRate);
+        multiResolutionAnalyzer.setWindow(requestedWindow.load());
+        
+        // the single FFT keeps following the rate, ready for when we switch back
+        newOrder = orderAuto;
+    }
+    
+    if ( newOrder == orderAuto )
+        newOrder = getFFTOrderForSampleRate(sampleRate);
+    
+    if ( newOrder != fftDataGenerator.getOrder() )
+    {
+        // the analysis buffers always hold the largest window, so the next FFT can run straight away
+        fftDataGenerator.changeOrder(newOrder);
+        setOverlap(overlap);
+    }
+    
+    auto newWindow = requestedWindow.load();
+    if ( newWindow != fftDataGenerator.getWindow() )
+    {
+        fftDataGenerator.changeWindow(newWindow);
+        
+        // frames under different windows don't average
+        transferFunctionAnalyzer.reset();
+    }
+    
+    // a new measurement starts from scratch
+    auto shouldMeasure = measuring.load();
+    if ( shouldMeasure && ! wasMeasuring )
+        transferFunctionAnalyzer.reset();
+    
+    wasMeasuring = shouldMeasure;
+}
+
+void PathProducer::runFFT(bool shouldShowMidSide, bool shouldMeasure)
+{
+    if ( ! useMultiResolution )
+        fftDataGenerator.produceFFTDataForRendering(leftAnalysisBuffer, rightAnalysisBuffer, shouldShowMidSide);
+    
+    // the output side is the left analysis buffer, the same samples the analyzer just used
+    if ( shouldMeasure )
+        transferFunctionAnalyzer.process(inputAnalysisBuffer,
+                                         leftAnalysisBuffer,
+                                         fftDataGenerator.getFFT(),
+                                         fftDataGenerator.getWindowingFunction());
+}
+
+SpectrogramComponent::SpectrogramComponent()
+{
+    using namespace juce;
+    
+    // same colours as the rest of the editor, from silence up to full scale
+    ColourGradient gradient;
+    gradient.addColour(0.0, Colours::black);
+    gradient.addColour(0.35, Colour(97u, 18u, 167u));
+    gradient.addColour(0.7, Colour(255u, 154u, 1u));
+    gradient.addColour(1.0, Colours::white);
+    
+    for ( size_t level = 0; level < colourLookup.size(); ++level )
+        colourLookup[level] = gradient.getColourAtPosition(level / 255.0).getPixelARGB();
+    
+    setOpaque(true);
+}
+
+void SpectrogramComponent::resized()
+{
+    // the history can't be stretched into the new size, start again
+    history = juce::Image(juce::Image::ARGB,
+                          juce::jmax(1, getWidth()),
+                          juce::jmax(1, getHeight()),
+                          true,
+                          juce::SoftwareImageType());
+    writePosition = 0;
+}
+
+void SpectrogramComponent::pushColumn(const std::vector<uint8_t>& levels)
+{
+    // a column built before the last resize
+    if ( (int) levels.size() != history.getHeight() )
+        return;
+    
+    {
+        juce::Image::BitmapData column(history, writePosition, 0, 1, history.getHeight(), juce::Image::BitmapData::writeOnly);
+        
+        for ( int y = 0; y < column.height; ++y )
+            *reinterpret_cast<juce::PixelARGB*>(column.getLinePointer(y)) = colourLookup[levels[(size_t) y]];
+    }
+    
+    writePosition = (writePosition + 1) % history.getWidth();
+    
+    repaint();
+}
+
+void SpectrogramComponent::paint(juce::Graphics& g)
+{
+    SIMPLEEQ_PROFILE_PAINT(SpectrogramPaint);
+    
+    auto width = history.getWidth();
+    auto height = history.getHeight();
+    
+    // oldest columns on the left: from the write position to the end, then from the start up to it
+    g.drawImage(history, 0, 0, width - writePosition, height, writePosition, 0, width - writePosition, height);
+    
+    if ( writePosition > 0 )
+        g.drawImage(history, width - writePosition, 0, writePosition, height, 0, 0, writePosition, height);
+}
+
+bool ResponseCurveComponent::toggleCapture(bool enabled)
+{
+    if ( ! enabled && analyzer == nullptr )
+        return true;
+    
+    auto& captureWriter = getAnalyzer().pathProducer.getCaptureWriter();
+    
+    if ( ! enabled )
+    {
+        captureWriter.stop();
+        return true;
+    }
+    
+    auto directory = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("SimpleEQ Captures");
+    return captureWriter.start(directory, analysisThreadPool->pool);
+}
+
+bool ResponseCurveComponent::isFullyRendered() const
+{
+    auto hasTraces = std::any_of(analyzerPaths.begin(), analyzerPaths.end(), [](const auto& path) { return ! path.isEmpty(); });
+    
+    return gridLayerIsValid && ! gridLayerIsPending && ( ! shouldShowFFTAnalysis || hasTraces );
+}
+
+void ResponseCurveComponent::onVBlank()
+{
+    bool analyzerChanged = false;
+    bool curveChanged = false;
+    
+    // the FFTs and paths are built on the shared analysis pool, we only queue the next round here.
+    // if the last round hasn't finished yet, it gets another frame
+    auto& pool = analysisThreadPool->pool;
+    auto now = juce::Time::getMillisecondCounterHiRes();
+    
+    // the first frame the analyzer is shown is also when it's made
+    auto* analyzerToRun = shouldShowFFTAnalysis ? &getAnalyzer() : nullptr;
+    
+    if( analyzerToRun != nullptr && now - lastAnalyzerQueuedMs >= minAnalyzerIntervalMs && ! pool.contains(&analyzerToRun->job) )
+    {
+        auto& analyzerJob = analyzerToRun->job;
+        auto& pathProducer = analyzerToRun->pathProducer;
+        
+        // whatever the last round finished
+        analyzerChanged |= pathProducer.pullPaths(analyzerPaths);
+        analyzerChanged |= pathProducer.pullMeasurementPaths(measurementPaths);
+        auto& captureWriter = pathProducer.getCaptureWriter();
+        captureWriter.service();
+        
+        // a file couldn't be made, so the capture ends here
+        if ( captureWriter.isCapturing() && captureWriter.hasFailed() )
+        {
+            captureWriter.stop();
+            
+            if ( onCaptureFailed != nullptr )
+                onCaptureFailed();
+        }
+        
+        const bool spectrogramIsShowing = spectrogram != nullptr && spectrogram->isShowing();
+        
+        if ( spectrogramIsShowing && pathProducer.pullSpectrogramColumn(spectrogramColumn) )
+            spectrogram->pushColumn(spectrogramColumn);
+        
+        analyzerJob.fftBounds = getAnalysisArea().toFloat();
+        analyzerJob.sampleRate = audioProcessor.getSampleRate();
+        analyzerJob.spectrogramRows = spectrogramIsShowing ? spectrogram->getHeight() : 0;
+        
+        pool.addJob(&analyzerJob, false);
+        lastAnalyzerQueuedMs = now;
+    }
+    
+    if ( parametersChanged.compareAndSetBool(false, true) )
+        ticksWaitingForProcessor = 0;
+    
+    // a new design from the audio thread (which also covers rate changes), so the curve is
+    // exactly what's being heard
+    if ( audioProcessor.getChainSnapshot(chainSnapshot, chainSnapshotVersion) )
+    {
+        curveChanged = true;
+        ticksWaitingForProcessor = -1;
+    }
+    else if ( ticksWaitingForProcessor >= 0 && ++ticksWaitingForProcessor > maxTicksWaitingForProcessor )
+    {
+        designChainHere();
+        curveChanged = true;
+        ticksWaitingForProcessor = -1;
+    }
+    
+    if ( curveChanged )
+    {
+        // the cuts take the curve off the bottom of the analysis area, so it can be anywhere below it
+        responseCurveIsValid = false;
+        repaint();
+    }
+    else if ( analyzerChanged )
+    {
+        // the analyzer paths are clamped to the analysis area
+        analyzerLayerIsValid = false;
+        repaint(getAnalysisArea().expanded(2));
+    }
+    else
+    {
+        ++numSkippedFrames;
+    }
+}
+
+// the audio thread isn't designing (not playing, or not prepared yet), so the curve still follows the knobs
+void ResponseCurveComponent::designChainHere()
+{
+    auto sampleRate = audioProcessor.getSampleRate();
+    
+    chainSnapshot = designChainSnapshot(getChainSettings(audioProcessor.getParameterValues()), sampleRate > 0.0 ? sampleRate : 44100.0);
+}
+
+// magnitude at every pixel column of the analysis area, and the white curve through them
+void ResponseCurveComponent::updateResponseCurve()
+{
+    using namespace juce;
+    
+    // auto responseArea = getLocalBounds();
+    auto responseArea = getAnalysisArea();
+    
+    auto w = responseArea.getWidth();
+    
+    //stores magnitudes. only reallocates when the width changes
+    mags.resize(w);
+    responseCurve.clear();
+    responseCurveIsValid = true;
+    
+    if ( mags.empty() )
+        return;
+    
+    // map pixel to frequency. map normalized pixel to its frequency in the range of human hearing
+    if ( (int) pixelFrequencies.size() != w )
+    {
+        pixelFrequencies.resize(w);
+        
+        for ( int i = 0; i < w; ++i)
+            pixelFrequencies[i] = (float) mapToLog10(double(i) / double(w), 20.0, 20000.0);
+    }
+    
+    // the whole chain at every pixel in one batch. the pixels are log spaced, so flat stretches
+    // are interpolated, well inside the 0.5dB or so a pixel is worth
+    evaluateMagnitudeAdaptive(chainSnapshot, pixelFrequencies.data(), mags.data(), w);
+    
+    //  convert vector of magnitudes to a path
+    responseCurve.preallocateSpace(3 * w);
+    
+    // max and min positions in the window
+    const double outputMin = responseArea.getBottom();
+    const double outputMax = responseArea.getY();
+    //map from source input
+    auto map = [outputMin, outputMax](double input)
+    {
+        return jmap(input, -24.0, 24.0, outputMin, outputMax);
+    };
+    
+    // new subpath with the first magnitude - left edge
+    responseCurve.startNewSubPath(responseArea.getX(), map (mags.front()));
+    
+    // lines for every other magnitude
+    for (size_t i = 1; i < mags.size(); ++i)
+    {
+        responseCurve.lineTo(responseArea.getX() + i, map(mags[i]));
+    }
+}
+
+void ResponseCurveComponent::paint (juce::Graphics& g)
+{
+    SIMPLEEQ_PROFILE_PAINT(ResponseCurvePaint);
+    
+    ++numPaints;
+    
+    using namespace juce;
+    
+    // pixels per point where we're being painted. a new display means new layers
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if ( scale != layerScale )
+    {
+        layerScale = scale;
+        gridLayerIsValid = analyzerLayerIsValid = curveLayerIsValid = false;
+        gridLayerIsPending = false;
+    }
+    
+    if ( ! gridLayerIsValid && ! gridLayerIsPending )
+        requestGridLayer();
+    
+    // the response only changes with the parameters, sample rate or size, not every frame
+    if ( ! responseCurveIsValid )
+    {
+        updateResponseCurve();
+        curveLayerIsValid = false;
+    }
+    
+    if ( ! curveLayerIsValid )
+    {
+        renderLayer(curveLayer, Image::ARGB, [this](Graphics& lg)
+        {
+            lg.setColour(Colours::white);
+            lg.strokePath(responseCurve, PathStrokeType(2.f));
+        });
+        curveLayerIsValid = true;
+    }
+    
+    if ( shouldShowFFTAnalysis && ! analyzerLayerIsValid )
+    {
+        renderLayer(analyzerLayer, Image::ARGB, [this](Graphics& lg) { drawAnalyzerTraces(lg); });
+        analyzerLayerIsValid = true;
+    }
+    
+    // the layers are exactly the component's size in physical pixels, so this is a straight copy
+    auto bounds = getLocalBounds().toFloat();
+    
+    // opaque, covers the whole component once it's there
+    if ( gridLayer.isValid() )
+        g.drawImage(gridLayer, bounds);
+    else
+        g.fillAll(Colours::black);
+    
+    if ( shouldShowFFTAnalysis )
+        g.drawImage(analyzerLayer, bounds);
+    
+    g.drawImage(curveLayer, bounds);
+}
+
+void ResponseCurveComponent::drawAnalyzerTraces(juce::Graphics& g)
+{
+    using namespace juce;
+    
+    // left/right, or mid/side when that's switched on
+    auto midSide = analyzerSettings.midSide;
+    
+    // the paths are built in our coordinates, no copy or transform needed
+    g.setColour(midSide ? Colours::lightgreen : Colours::skyblue);
+    g.strokePath(analyzerPaths[midSide ? MidSpectrum : LeftSpectrum], PathStrokeType(1.f));
+    
+    g.setColour(midSide ? Colours::hotpink : Colours::lightyellow);
+    g.strokePath(analyzerPaths[midSide ? SideSpectrum : RightSpectrum], PathStrokeType(1.f));
+    
+    // measured response under the theoretical one, coherence faintly behind it
+    if ( analyzerSettings.measuring )
+    {
+        g.setColour(Colours::grey.withAlpha(0.6f));
+        g.strokePath(measurementPaths[CoherenceTrace], PathStrokeType(1.f));
+        
+        g.setColour(Colours::cyan);
+        g.strokePath(measurementPaths[MagnitudeTrace], PathStrokeType(1.5f));
+    }
+}
+
+void ResponseCurveComponent::resized()
+{
+    // new size, new layers. new width, new pixel columns
+    gridLayerIsValid = analyzerLayerIsValid = curveLayerIsValid = false;
+    gridLayerIsPending = false;
+    responseCurveIsValid = false;
+}
+
+void ResponseCurveComponent::requestGridLayer()
+{
+    using namespace juce;
+    
+    auto bounds = getLocalBounds();
+    auto renderArea = getRenderArea();
+    auto analysisArea = getAnalysisArea();
+    auto width = jmax(1, roundToInt(bounds.getWidth() * layerScale));
+    auto height = jmax(1, roundToInt(bounds.getHeight() * layerScale));
+    auto generation = ++gridGeneration;
+    
+    gridLayerIsPending = true;
+    
+    SafePointer<ResponseCurveComponent> safePtr(this);
+    
+    analysisThreadPool->pool.addJob([safePtr, generation, bounds, renderArea, analysisArea, width, height]()
+    {
+        // a software image, so nothing here needs the message thread or the native renderer
+        Image image(Image::RGB, width, height, false, SoftwareImageType());
+        
+        {
+            Graphics g(image);
+            g.addTransform(AffineTransform::scale((float) width / (float) jmax(1, bounds.getWidth()),
+                                                  (float) height / (float) jmax(1, bounds.getHeight())));
+            drawGrid(g, bounds, renderArea, analysisArea);
+        }
+        
+        MessageManager::callAsync([safePtr, generation, image]()
+        {
+            auto* comp = safePtr.getComponent();
+            
+            if ( comp == nullptr || generation != comp->gridGeneration )
+                return;
+            
+            comp->gridLayer = image;
+            comp->gridLayerIsValid = true;
+            comp->gridLayerIsPending = false;
+            comp->repaint();
+        });
+    });
+}
+
+// grid, labels and border, everything that only changes with the size
+void ResponseCurveComponent::drawGrid(juce::Graphics& g,
+                                      juce::Rectangle<int> bounds,
+                                      juce::Rectangle<int> renderArea,
+                                      juce::Rectangle<int> analysisArea)
+{
+    using namespace juce;
+    
+    // (the layer is opaque, so we must completely fill it with a solid colour)
+    g.fillAll (Colours::black);
+    
+    // array to loop thru to convert frequencies to window space and draw as vertical lines
+    Array<float> freqs
+    {
+        20, /*30, 40,*/ 50, 100,
+        200,/*300, 400,*/ 500, 1000,
+        2000, /*3000, 4000,*/ 5000, 10000,
+        20000
+    };
+    
+    // cache info about analysis area
+    auto left = analysisArea.getX();
+    auto right = analysisArea.getRight();
+    auto top = analysisArea.getY();
+    auto bottom = analysisArea.getBottom();
+    auto width = analysisArea.getWidth();
+    
+    // cache into an array
+    Array<float> xs;
+    for ( auto f : freqs )
+    {
+        auto normX = mapFromLog10(f, 20.f, 20000.f);
+        xs.add(left + width * normX);
+    }
+    
+    // set color to white and loop thru freqs and map from linear space to normalized position
+    g.setColour(Colours::dimgrey);
+    for (auto x : xs )
+    {
+
+        g.drawVerticalLine(x, top, bottom);
+    }
+    
+    // gain lines
+    Array<float> gain {
+        -24, -12, 0, 12, 24
+    };
+    
+    for (auto gDb : gain)
+    {
+        auto y = jmap(gDb, -24.f, 24.f, float(bottom), float(top));
+
+        // set middle line to green, dark grey for the rest
+        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::darkgrey );
+        g.drawHorizontalLine(y, left, right);
+    }
+    
+    // frequency labels
+    g.setColour(Colours::lightgrey);
+    const int fontHeight = 10;
+    g.setFont(fontHeight);
+    
+    // loop thru freqs and xs and draw text above the grid
+    for (int i = 0; i < freqs.size(); ++i)
+    {
+        auto f = freqs[i];
+        auto x = xs[i];
+        
+        // suffix handling
+        bool addK = false;
+        String str;
+        if( f > 999.f )
+        {
+            addK = true;
+            f /= 1000.f;
+        }
+        
+        str << f;
+        if( addK )
+            str << "k";
+        str<< "Hz";
+        
+        // rectangle around string
+        auto textWidth = g.getCurrentFont().getStringWidth(str);
+        
+        Rectangle<int> r;
+        r.setSize(textWidth, fontHeight);
+        r.setCentre(x, 6);
+        r.setY(1);
+        
+        g.drawFittedText(str, r, juce::Justification::centred, 1);
+    }
+    
+    // gain labels
+    for ( auto gDb : gain )
+    {
+        auto y = jmap(gDb, -24.f, 24.f, float(bottom), float(top));
+        
+        // string with gain value
+        String str;
+        if (gDb > 0)
+            str << "+";
+        str << gDb;
+        
+        auto textWidth = g.getCurrentFont().getStringWidth(str);
+        
+        Rectangle<int> r;
+        r.setSize(textWidth, fontHeight);
+        r.setX(bounds.getWidth() - textWidth);
+        r.setCentre(r.getCentreX(), y);
+        
+        g.setColour(gDb == 0.f ? Colour(0u, 172u, 1u) : Colours::lightgrey );
+        
+        g.drawFittedText(str, r, juce::Justification::centred, 1);
+        
+        // spectrum labels
+        str.clear();
+        str << (gDb - 24.f);
+        
+        r.setX(1);
+        textWidth = g.getCurrentFont().getStringWidth(str);
+        r.setSize(textWidth, fontHeight);
+        g.setColour(Colours::lightgrey);
+        g.drawFittedText(str, r, juce::Justification::centred, 1);
+    }
+    
+    g.setColour(Colours::orange);
+    g.drawRoundedRectangle(renderArea.toFloat(), 4.f, 1.f);
+}
+
+juce::Rectangle<int> ResponseCurveComponent::getRenderArea()
+{
+    auto bounds = getLocalBounds();
+    
+    bounds.removeFromTop(12);
+    bounds.removeFromBottom(2);
+    bounds.removeFromLeft(20);
+    bounds.removeFromRight(20);
+    
+    return bounds;
+}
+
+juce::Rectangle<int> ResponseCurveComponent::getAnalysisArea()
+{
+    auto bounds = getRenderArea();
+    bounds.removeFromTop(4);
+    bounds.removeFromBottom(4);
+    
+    return bounds;
+}
+//==============================================================================
+SimpleEQAudioProcessorEditor::SimpleEQAudioProcessorEditor (SimpleEQAudioProcessor& p)
+    : AudioProcessorEditor (&p), audioProcessor (p),
+peakFreqSlider(*audioProcessor.apvts.getParameter(getParameterID(PeakFreqParameter)), "Hz"),
+peakGainSlider(*audioProcessor.apvts.getParameter(getParameterID(PeakGainParameter)), "dB"),
+peakQualitySlider(*audioProcessor.apvts.getParameter(getParameterID(PeakQualityParameter)), ""),
+lowCutFreqSlider(*audioProcessor.apvts.getParameter(getParameterID(LowCutFreqParameter)), "Hz"),
+highCutFreqSlider(*audioProcessor.apvts.getParameter(getParameterID(HighCutFreqParameter)), "Hz"),
+lowCutSlopeSlider(*audioProcessor.apvts.getParameter(getParameterID(LowCutSlopeParameter)), "dB/Oct"),
+highCutSlopeSlider(*audioProcessor.apvts.getParameter(getParameterID(HighCutSlopeParameter)), "dB/Oct"),
+
+responseCurveComponent(audioProcessor),
+peakFreqSliderAttachement(audioProcessor.apvts, getParameterID(PeakFreqParameter), peakFreqSlider),
+peakGainSliderAttachment(audioProcessor.apvts, getParameterID(PeakGainParameter), peakGainSlider),
+peakQualitySliderAttachment(audioProcessor.apvts, getParameterID(PeakQualityParameter), peakQualitySlider),
+lowCutFreqSliderAttachment(audioProcessor.apvts, getParameterID(LowCutFreqParameter), lowCutFreqSlider),
+highCutFreqSliderAttachment(audioProcessor.apvts, getParameterID(HighCutFreqParameter), highCutFreqSlider),
+lowCutSlopeSliderAttachment(audioProcessor.apvts, getParameterID(LowCutSlopeParameter), lowCutSlopeSlider),
+highCutSlopeSliderAttachment(audioProcessor.apvts, getParameterID(HighCutSlopeParameter), highCutSlopeSlider),
+
+lowCutBypassButtonAttachment(audioProcessor.apvts, getParameterID(LowCutBypassedParameter), lowCutBypassButton),
+peakBypassButtonAttachment(audioProcessor.apvts, getParameterID(PeakBypassedParameter), peakBypassButton),
+highCutBypassButtonAttachment(audioProcessor.apvts, getParameterID(HighCutBypassedParameter), highCutBypassButton),
+analyzerEnabledButtonAttachment(audioProcessor.apvts, getParameterID(AnalyzerEnabledParameter), analyzerEnabledButton)
+{
+    // Make sure that before the constructor has finished, you've set the
+    // editor's size to whatever you need it to be.
+    
+    // min max values
+    peakFreqSlider.labels.add({0.f, "20Hz"});
+    peakFreqSlider.labels.add({1.f, "20kHz"});
+    
+    peakGainSlider.labels.add({0.f, "-24dB"});
+    peakGainSlider.labels.add({1.f, "+24dB"});
+    
+    peakQualitySlider.labels.add({0.f, "0.1"});
+    peakQualitySlider.labels.add({1.f, "10.0"});
+    
+    lowCutFreqSlider.labels.add({0.f, "20Hz"});
+    lowCutFreqSlider.labels.add({1.f, "20kHz"});
+    
+    highCutFreqSlider.labels.add({0.f, "20Hz"});
+    highCutFreqSlider.labels.add({1.f, "20kHz"});
+    
+    lowCutSlopeSlider.labels.add({0.f, "12"});
+    lowCutSlopeSlider.labels.add({1.f, "48"});
+    
+    highCutSlopeSlider.labels.add({0.f, "12"});
+    highCutSlopeSlider.labels.add({1.f, "48"});
+    
+    for ( auto* comp : getComps())
+    {
+        addAndMakeVisible(comp);
+    }
+    
+    // hidden until the spectrogram button turns it on
+    addChildComponent(spectrogramComponent);
+    // get parameters and add a listener
+    peakBypassButton.setLookAndFeel(lnf.get());
+    lowCutBypassButton.setLookAndFeel(lnf.get());
+    highCutBypassButton.setLookAndFeel(lnf.get());
+    analyzerEnabledButton.setLookAndFeel(lnf.get());
+    
+    // on click lamdas to change enablement of sliders
+    // makes sure class(editor) is still in existence when using onclick lamda
+    auto safePtr = juce::Component::SafePointer<SimpleEQAudioProcessorEditor>(this);
+    peakBypassButton.onClick = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto bypassed = comp->peakBypassButton.getToggleState();
+            
+            comp->peakFreqSlider.setEnabled( !bypassed );
+            comp->peakGainSlider.setEnabled( !bypassed );
+            comp->peakQualitySlider.setEnabled( !bypassed);
+        }
+    };
+    
+    lowCutBypassButton.onClick = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto bypassed = comp->lowCutBypassButton.getToggleState();
+            
+            comp->lowCutFreqSlider.setEnabled( !bypassed );
+            comp->lowCutSlopeSlider.setEnabled( !bypassed );
+        }
+    };
+    
+    highCutBypassButton.onClick = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto bypassed = comp->highCutBypassButton.getToggleState();
+            
+            comp->highCutFreqSlider.setEnabled( !bypassed );
+            comp->highCutSlopeSlider.setEnabled( !bypassed );
+        }
+    };
+    
+    analyzerEnabledButton.onClick = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto enabled = comp->analyzerEnabledButton.getToggleState();
+            comp->responseCurveComponent.toggleAnalysisEnablement(enabled);
+        }
+    };
+    
+    measureButton.onClick = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto enabled = comp->measureButton.getToggleState();
+            comp->responseCurveComponent.toggleMeasurement(enabled);
+        }
+    };
+    
+    captureButton.onClick = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto enabled = comp->captureButton.getToggleState();
+            
+            // couldn't create the capture directory
+            if ( ! comp->responseCurveComponent.toggleCapture(enabled) )
+                comp->captureButton.setToggleState(false, juce::dontSendNotification);
+        }
+    };
+    
+    // or a capture file, later on
+    responseCurveComponent.onCaptureFailed = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+            comp->captureButton.setToggleState(false, juce::dontSendNotification);
+    };
+    
+    spectrogramButton.onClick = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            // the spectrogram gets its own strip under the response curve
+            auto enabled = comp->spectrogramButton.getToggleState();
+            comp->spectrogramComponent.setVisible(enabled);
+            comp->responseCurveComponent.setSpectrogram(enabled ? &comp->spectrogramComponent : nullptr);
+            comp->setSize(comp->getWidth(), enabled ? 400 + spectrogramHeight : 400);
+        }
+    };
+    
+    midSideButton.onClick = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto enabled = comp->midSideButton.getToggleState();
+            comp->responseCurveComponent.toggleMidSideAnalysis(enabled);
+        }
+    };
+    
+    // combo box item ids are the FFTOrder / AnalyzerWindow values + 1, since 0 means "nothing selected"
+    analyzerOrderComboBox.addItem("Auto", orderAuto + 1);
+    analyzerOrderComboBox.addItem("2048", order2048 + 1);
+    analyzerOrderComboBox.addItem("4096", order4096 + 1);
+    analyzerOrderComboBox.addItem("8192", order8192 + 1);
+    analyzerOrderComboBox.addItem("Multi-res", orderMultiResolution + 1);
+    analyzerOrderComboBox.setSelectedId(orderAuto + 1, juce::dontSendNotification);
+    
+    analyzerOrderComboBox.onChange = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto order = static_cast<FFTOrder>(comp->analyzerOrderComboBox.getSelectedId() - 1);
+            comp->responseCurveComponent.setAnalyzerOrder(order);
+        }
+    };
+    
+    analyzerWindowComboBox.addItem("Blackman-Harris", BlackmanHarris + 1);
+    analyzerWindowComboBox.addItem("Hann", Hann + 1);
+    analyzerWindowComboBox.addItem("Flat Top", FlatTop + 1);
+    analyzerWindowComboBox.setSelectedId(BlackmanHarris + 1, juce::dontSendNotification);
+    
+    analyzerWindowComboBox.onChange = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto window = static_cast<AnalyzerWindow>(comp->analyzerWindowComboBox.getSelectedId() - 1);
+            comp->responseCurveComponent.setAnalyzerWindow(window);
+        }
+    };
+    
+    analyzerSmoothingComboBox.addItem("No Smoothing", NoSmoothing + 1);
+    analyzerSmoothingComboBox.addItem("1/3 Oct", ThirdOctave + 1);
+    analyzerSmoothingComboBox.addItem("1/6 Oct", SixthOctave + 1);
+    analyzerSmoothingComboBox.addItem("1/12 Oct", TwelfthOctave + 1);
+    analyzerSmoothingComboBox.setSelectedId(NoSmoothing + 1, juce::dontSendNotification);
+    
+    analyzerSmoothingComboBox.onChange = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto smoothing = static_cast<SpectrumSmoothing>(comp->analyzerSmoothingComboBox.getSelectedId() - 1);
+            comp->responseCurveComponent.setAnalyzerSmoothing(smoothing);
+        }
+    };
+    
+    // how the frames between two redraws are combined, FrameMerge + 1
+    analyzerMergeComboBox.addItem("Latest", MergeLatest + 1);
+    analyzerMergeComboBox.addItem("Max", MergeMax + 1);
+    analyzerMergeComboBox.addItem("Average", MergeAverage + 1);
+    analyzerMergeComboBox.setSelectedId(MergeLatest + 1, juce::dontSendNotification);
+    
+    analyzerMergeComboBox.onChange = [safePtr]()
+    {
+        if ( auto* comp = safePtr.getComponent() )
+        {
+            auto frameMerge = static_cast<FrameMerge>(comp->analyzerMergeComboBox.getSelectedId() - 1);
+            comp->responseCurveComponent.setAnalyzerFrameMerge(frameMerge);
+        }
+    };
+    
+   #if SIMPLEEQ_PAINT_PROFILER
+    paintProfilerOverlay.getResponseViewFrames = [this]
+    {
+        return PaintProfilerOverlay::ResponseViewFrames { responseCurveComponent.getNumPaints(),
+                                                          responseCurveComponent.getNumSkippedFrames() };
+    };
+    addChildComponent(paintProfilerOverlay);
+    setWantsKeyboardFocus(true);
+   #endif
+    
+    setSize (830, 400);
+}
+
+SimpleEQAudioProcessorEditor::~SimpleEQAudioProcessorEditor()
+{
+    peakBypassButton.setLookAndFeel(nullptr);
+    lowCutBypassButton.setLookAndFeel(nullptr);
+    highCutBypassButton.setLookAndFeel(nullptr);
+    analyzerEnabledButton.setLookAndFeel(nullptr);
+}
+
+//==============================================================================
+void SimpleEQAudioProcessorEditor::paint (juce::Graphics& g)
+{
+    SIMPLEEQ_PROFILE_PAINT(EditorPaint);
+    
+    using namespace juce;
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    g.fillAll (Colours::black);
+
+}
+
+
+
+
+void SimpleEQAudioProcessorEditor::resized()
+{
+    // This is generally where you'll want to lay out the positions of any
+    // subcomponents in your editor..
+    
+    auto bounds = getLocalBounds();
+    
+    //analyzer bypass button area
+    auto analyzerEnabledArea = bounds.removeFromTop(25);
+    
+    // analyzer options to the right of the analyzer button
+    auto analyzerOptionsArea = analyzerEnabledArea.withTrimmedLeft(110);
+    analyzerOptionsArea.removeFromTop(2);
+    
+    analyzerEnabledArea.setWidth(100);
+    analyzerEnabledArea.setX(5);
+    analyzerEnabledArea.removeFromTop(2);
+    
+    analyzerEnabledButton.setBounds(analyzerEnabledArea);
+    
+    midSideButton.setBounds(analyzerOptionsArea.removeFromLeft(50));
+    analyzerOrderComboBox.setBounds(analyzerOptionsArea.removeFromLeft(80));
+    analyzerOptionsArea.removeFromLeft(5);
+    analyzerWindowComboBox.setBounds(analyzerOptionsArea.removeFromLeft(110));
+    analyzerOptionsArea.removeFromLeft(5);
+    analyzerSmoothingComboBox.setBounds(analyzerOptionsArea.removeFromLeft(95));
+    analyzerOptionsArea.removeFromLeft(5);
+    analyzerMergeComboBox.setBounds(analyzerOptionsArea.removeFromLeft(85));
+    analyzerOptionsArea.removeFromLeft(5);
+    spectrogramButton.setBounds(analyzerOptionsArea.removeFromLeft(100));
+    analyzerOptionsArea.removeFromLeft(5);
+    measureButton.setBounds(analyzerOptionsArea.removeFromLeft(80));
+    analyzerOptionsArea.removeFromLeft(5);
+    captureButton.setBounds(analyzerOptionsArea.removeFromLeft(75));
+    
+    bounds.removeFromTop(5);
+    
+    // the editor grows by the spectrogram strip, so everything else keeps its size
+    auto spectrogramStripHeight = spectrogramComponent.isVisible() ? spectrogramHeight : 0;
+    
+    // JUCE LIVE CONSTANT lets you adjust visuals while running
+    float hRatio = 25.f / 100.f; // JUCE_LIVE_CONSTANT(25) / 100.f;
+    //sets space aside for spectogram
+    auto responseArea = bounds.removeFromTop((bounds.getHeight() - spectrogramStripHeight) * hRatio);
+    
+    responseCurveComponent.setBounds(responseArea);
+    
+    if ( spectrogramStripHeight > 0 )
+    {
+        bounds.removeFromTop(5);
+        spectrogramComponent.setBounds(bounds.removeFromTop(spectrogramStripHeight - 5).reduced(5, 0));
+    }
+    
+    // creates space between sliders and spectrum analyzer
+    bounds.removeFromTop(5);
+    
+    auto lowCutArea = bounds.removeFromLeft(bounds.getWidth() * .33);
+    //after taking 33% for the left side, there is 66% left, so take half of that for right side
+    auto highCutArea = bounds.removeFromRight(bounds.getWidth() * .5);
+    
+    lowCutBypassButton.setBounds(lowCutArea.removeFromTop(25));
+    lowCutFreqSlider.setBounds(lowCutArea.removeFromTop(bounds.getHeight() * 0.5));
+    lowCutSlopeSlider.setBounds(lowCutArea);
+    
+    highCutBypassButton.setBounds(highCutArea.removeFromTop(25));
+    highCutFreqSlider.setBounds(highCutArea.removeFromTop(bounds.getHeight() * 0.5));
+    highCutSlopeSlider.setBounds(highCutArea);
+    
+    //peak slider at top,
+    peakBypassButton.setBounds(bounds.removeFromTop(25));
+    peakFreqSlider.setBounds(bounds.removeFromTop(bounds.getHeight() * .33));
+    peakGainSlider.setBounds(bounds.removeFromTop(bounds.getHeight() * .5));
+    peakQualitySlider.setBounds(bounds);
+    
+   #if SIMPLEEQ_PAINT_PROFILER
+    paintProfilerOverlay.setBounds(responseArea.getX() + 25, responseArea.getY() + 15, 330, PaintProfilerOverlay::getPreferredHeight());
+   #endif
+}
+
+#if SIMPLEEQ_PAINT_PROFILER
+bool SimpleEQAudioProcessorEditor::keyPressed(const juce::KeyPress& key)
+{
+    if ( key == juce::KeyPress('p') )
+    {
+        paintProfilerOverlay.setVisible(! paintProfilerOverlay.isVisible());
+        return true;
+    }
+    
+    if ( key == juce::KeyPress('d') )
+    {
+        auto file = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("SimpleEQ Paint Profile.txt");
+        
+        juce::String frames;
+        frames << "this editor's response view: " << (juce::int64) responseCurveComponent.getNumPaints() << " paints, "
+               << (juce::int64) responseCurveComponent.getNumSkippedFrames() << " refreshes with nothing new" << juce::newLine;
+        
+        // say how it went where it'll be seen, not just in a debug build's log
+        paintProfilerOverlay.showMessage(PaintProfiler::getInstance().dumpToFile(file, frames)
+                                            ? "wrote " + file.getFileName()
+                                            : "couldn't write " + file.getFullPathName());
+        paintProfilerOverlay.setVisible(true);
+        
+        return true;
+    }
+    
+    return false;
+}
+#endif
+
+std::vector<juce::Component*> SimpleEQAudioProcessorEditor::getComps()
+{
+    return
+    {
+        &peakFreqSlider,
+        &peakGainSlider,
+        &peakQualitySlider,
+        &lowCutFreqSlider,
+        &highCutFreqSlider,
+        &lowCutSlopeSlider,
+        &highCutSlopeSlider,
+        &responseCurveComponent,
+        
+        &lowCutBypassButton,
+        &highCutBypassButton,
+        &peakBypassButton,
+        &analyzerEnabledButton,
+        &midSideButton,
+        &spectrogramButton,
+        &measureButton,
+        &captureButton,
+        &analyzerOrderComboBox,
+        &analyzerWindowComboBox,
+        &analyzerSmoothingComboBox,
+        &analyzerMergeComboBox
+    };
+}
@@ -1,347 +1,1785 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-
-enum FFTOrder
-{
-    order2048 = 11,
-    order4096 = 12,
-    order8192 = 13
-};
-
-template<typename BlockType>
-struct FFTDataGenerator
-{
-    //produces teh FFT data from an audio buffer
-    void produceFFTDataForRendering( const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
-    {
-        const auto fftSize = getFFTSize();
-        
-        fftData.assign(fftData.size(), 0);
-        auto* readIndex = audioData.getReadPointer(0);
-        std::copy(readIndex, readIndex + fftSize, fftData.begin());
-        
-        //first apply a windowing function to our data
-        window->multiplyWithWindowingTable (fftData.data(), fftSize);       //[1]
-        
-        //then render our FFT data
-        forwardFFT->performFrequencyOnlyForwardTransform (fftData.data());  //[2]
-        
-        int numBins = (int) fftSize / 2;
-        
-        //normalize the fft values
-        for (int i = 0; i < numBins; ++i)
-        {
-            fftData[i] /= (float) numBins;
-        }
-        
-        //convert them to decibels
-        for (int i = 0; i < numBins; ++i)
-        {
-            fftData[i] = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
-        }
-        
-        fftDataFifo.push(fftData);
-    }
-    
-    void changeOrder(FFTOrder newOrder)
-    {
-        // when you change the order, recreate the window, forwardFFT, fifo, fftData
-        //also reset the fifoIndex
-        //things that need recreating should be created on the heap via std::make_unique<>
-        
-        order = newOrder;
-        auto fftSize = getFFTSize();
-        
-        forwardFFT = std::make_unique<juce::dsp::FFT>(order);
-        window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
-        
-        fftData.clear();
-        fftData.resize(fftSize * 2, 0);
-        
-        fftDataFifo.prepare(fftData.size());
-    }
-    //=============================================================
-    int getFFTSize() const { return 1 << order; }
-    int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
-    //=============================================================
-    bool getFFTData(BlockType& fftData) { return fftDataFifo.pull(fftData); }
-private:
-    FFTOrder order;
-    BlockType fftData;
-    std::unique_ptr<juce::dsp::FFT> forwardFFT;
-    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
-    
-    Fifo<BlockType> fftDataFifo;
-};
-
-// class to take FFTData, bounding box, FFT size, bin width and spit out a path
-template<typename PathType>
-struct AnalyzerPathGenerator
-{
-    /*
-     converts 'renderData[] into a juce::Path
-     */
-    void generatePath(const std::vector<float>& renderData,
-                      juce::Rectangle<float> fftBounds,
-                      int fftSize,
-                      float binWidth,
-                      float negativeInfinity)
-    {
-        auto top = fftBounds.getY();
-        auto bottom = fftBounds.getHeight();
-        auto width = fftBounds.getWidth();
-        
-        int numBins = (int)fftSize / 2;
-        
-        PathType p;
-        p.preallocateSpace(3 * (int)fftBounds.getWidth());
-        
-        auto map = [bottom, top, negativeInfinity](float v)
-        {
-            return juce::jmap(v,
-                              negativeInfinity, 0.f,
-                              float(bottom), top);
-        };
-        
-        auto y = map(renderData[0]);
-        
-        jassert( !std::isnan(y) && !std::isinf(y) );
-        
-        p.startNewSubPath(0, y);
-        
-        const int pathResolution = 2;
-        
-        for( int binNum = 1; binNum < numBins; binNum += pathResolution )
-        {
-            y = map(renderData[binNum]);
-            
-            jassert( !std::isnan(y) && !std::isinf(y) );
-            
-            if( !std::isnan(y) && !std::isinf(y) )
-            {
-                auto binFreq = binNum * binWidth;
-                auto normalizedBinX = juce::mapFromLog10(binFreq, 20.f, 20000.f);
-                int binX = std::floor(normalizedBinX * width);
-                p.lineTo(binX, y);
-            }
-        }
-        
-        pathFifo.push(p);
-    }
-    //===================================================================================
-    int getNumPathsAvailable() const { return pathFifo.getNumAvailableForReading(); }
-    bool getPath(PathType& path) { return pathFifo.pull(path); }
-private:
-    Fifo<PathType> pathFifo;
-};
-
-struct LookAndFeel : juce::LookAndFeel_V4
-{
-    void drawRotarySlider (juce::Graphics&,
-                           int x, int y, int width, int height,
-                           float sliderPosProportional,
-                           float rotaryStartAngle,
-                           float rotaryEndAngle,
-                           juce::Slider&) override;
-    
-    void drawToggleButton (juce::Graphics &g,
-                           juce::ToggleButton & toggleButton,
-                           bool shouldDrawButtonAsHighlighted,
-                           bool shouldDrawButtonAsDown) override;
-    
-};
-
-struct RotarySliderWithLabels : juce::Slider
-{
-    RotarySliderWithLabels(juce::RangedAudioParameter& rap, const juce::String& unitSuffix) :                                                                   juce::Slider(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag,
-                                        juce::Slider::TextEntryBoxPosition::NoTextBox),
-                                        param(&rap),
-                                        suffix(unitSuffix)
-    {
-        setLookAndFeel(&lnf);
-    }
-    
-    ~RotarySliderWithLabels()
-    {
-        setLookAndFeel(nullptr);
-    }
-    
-    struct LabelPos
-    {
-        float pos;
-        juce::String label;
-    };
-    
-    juce::Array<LabelPos> labels;
-    
-    void paint(juce::Graphics& g) override;
-    juce::Rectangle<int> getSliderBounds() const;
-    int getTextHeight() const {return 14; }
-    juce::String getDisplayString() const;
-    
-private:
-    LookAndFeel lnf;
-    
-    juce::RangedAudioParameter* param;
-    juce::String suffix;
-};
-
-struct PathProducer
-{
-    PathProducer(SingleChannelSampleFifo<SimpleEQAudioProcessor::BlockType>& scsf) :
-    leftChannelFifo(&scsf)
-    {
-        // split audio spectrum into 2048 equally sized bins to store magnitude level for a specific range of frequencies
-        leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
-        monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
-    }
-    void process(juce::Rectangle<float> fftbounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
-private:
-    // convert audio samples to FFT data
-    SingleChannelSampleFifo<SimpleEQAudioProcessor::BlockType>* leftChannelFifo;
-    
-    // mono buffer to ferry blocks of audio through
-    juce::AudioBuffer<float> monoBuffer;
-    
-    FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
-    
-    AnalyzerPathGenerator<juce::Path> pathProducer;
-    
-    juce::Path leftChannelFFTPath;
-};
-
-struct ResponseCurveComponent: juce::Component, juce::AudioProcessorParameter::Listener, juce::Timer
-{
-    ResponseCurveComponent(SimpleEQAudioProcessor&);
-    ~ResponseCurveComponent();
-    void parameterValueChanged (int parameterIndex, float newValue) override;
-    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override { }
-    
-    void timerCallback() override;
-    
-    void paint(juce::Graphics& g) override;
-    void resized() override;
-    
-    void toggleAnalysisEnablement(bool enabled)
-    {
-        shouldShowFFTAnalysis = enabled;
-    }
-    
-private:
-    SimpleEQAudioProcessor& audioProcessor;
-    juce::Atomic<bool> parametersChanged { false };
-    
-    void updateChain();
-    
-    MonoChain monoChain;
-    
-    // pre rendered response curve grid
-    juce::Image background;
-    
-    // area to draw background grid
-    juce::Rectangle<int> getRenderArea();
-    
-    juce::Rectangle<int> getAnalysisArea();
-    
-    PathProducer leftPathProducer, rightPathProducer;
-    
-    bool shouldShowFFTAnalysis = true;
-};
-
-
-//==============================================================================
-//
-struct PowerButton : juce::ToggleButton { };
-struct AnalyzerButton : juce::ToggleButton
-{
-    // computes random path the toggle button will draw
-    void resized() override
-    {
-        auto bounds = getLocalBounds();
-        auto insetRect = bounds.reduced(4);
-        
-        randomPath.clear();
-        
-        juce::Random r;
-        
-        randomPath.startNewSubPath(insetRect.getX(),
-                                   insetRect.getY() + insetRect.getHeight() * r.nextFloat());
-        
-        for ( auto x = insetRect.getX() + 1; x < insetRect.getRight(); x += 2 )
-        {
-            randomPath.lineTo(x,
-                              insetRect.getY() + insetRect.getHeight() * r.nextFloat());
-        }
-        
-    }
-    
-    juce::Path randomPath;
-};
-/**
-*/
-class SimpleEQAudioProcessorEditor  : public juce::AudioProcessorEditor
-{
-public:
-    SimpleEQAudioProcessorEditor (SimpleEQAudioProcessor&);
-    ~SimpleEQAudioProcessorEditor() override;
-
-    //==============================================================================
-    void paint (juce::Graphics&) override;
-    void resized() override;
-
-private:
-    // This reference is provided as a quick way for your editor to
-    // access the processor object that created it.
-    SimpleEQAudioProcessor& audioProcessor;
-    
-    //query an atomic flag to decide if the chain needs updating and if component needs to be repainted
-//    juce::Atomic<bool> parametersChanged { false };
-    
-    RotarySliderWithLabels peakFreqSlider,
-                        peakGainSlider,
-                        peakQualitySlider,
-                        lowCutFreqSlider,
-                        highCutFreqSlider,
-                        lowCutSlopeSlider,
-                        highCutSlopeSlider;
-    
-    ResponseCurveComponent responseCurveComponent;
-    
-                        
-    using APVTS = juce::AudioProcessorValueTreeState;
-    using Attachment = APVTS::SliderAttachment;
-    
-    Attachment peakFreqSliderAttachement,
-                peakGainSliderAttachment,
-                peakQualitySliderAttachment,
-                lowCutFreqSliderAttachment,
-                highCutFreqSliderAttachment,
-                lowCutSlopeSliderAttachment,
-                highCutSlopeSliderAttachment;
-    
-    PowerButton lowCutBypassButton, peakBypassButton, highCutBypassButton;
-    AnalyzerButton analyzerEnabledButton;
-    
-    using ButtonAttachment = APVTS::ButtonAttachment;
-    ButtonAttachment    lowCutBypassButtonAttachment,
-                        peakBypassButtonAttachment,
-                        highCutBypassButtonAttachment,
-                        analyzerEnabledButtonAttachment;
-    
-    std::vector<juce::Component*> getComps();
-    
-    LookAndFeel lnf;
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessorEditor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "AnalyzerCore.h"
+#include "SpectrumCaptureFormat.h"
+#include "PaintProfiler.h"
+
+enum FFTOrder
+{
+    orderAuto = 0, // pick the order from the sample rate, see getFFTOrderForSampleRate()
+    orderMultiResolution = 1, // use the MultiResolutionAnalyzer instead of a single FFT
+    order2048 = 11,
+    order4096 = 12,
+    order8192 = 13
+};
+
+constexpr FFTOrder minFFTOrder = order2048;
+constexpr FFTOrder maxFFTOrder = order8192;
+constexpr int numFFTOrders = maxFFTOrder - minFFTOrder + 1;
+
+/*
+ keeps the bin width close to 48000 / 2048 (~23Hz) at any sample rate:
+ 44.1/48k -> 2048, 88.2/96k -> 4096, 176.4/192k -> 8192
+ */
+inline FFTOrder getFFTOrderForSampleRate(double sampleRate)
+{
+    auto order = (int) order2048 + juce::roundToInt(std::log2(juce::jmax(1.0, sampleRate) / 48000.0));
+    return static_cast<FFTOrder>(juce::jlimit((int) minFFTOrder, (int) maxFFTOrder, order));
+}
+
+enum AnalyzerWindow
+{
+    BlackmanHarris,
+    Hann,
+    FlatTop,
+    NumAnalyzerWindows
+};
+
+inline juce::dsp::WindowingFunction<float>::WindowingMethod getWindowingMethod(AnalyzerWindow analyzerWindow)
+{
+    using Method = juce::dsp::WindowingFunction<float>;
+    
+    switch (analyzerWindow)
+    {
+        case Hann:      return Method::hann;
+        case FlatTop:   return Method::flatTop;
+        case BlackmanHarris:
+        case NumAnalyzerWindows:
+            break;
+    }
+    
+    return Method::blackmanHarris;
+}
+
+/*
+ circular buffer holding the most recent samples of one channel.
+ incoming blocks are written in place, nothing is ever shifted, and the
+ analysis window is read out (oldest sample first) only when an FFT is due.
+ */
+struct AnalysisRingBuffer
+{
+    void prepare(int capacity)
+    {
+        buffer.clear();
+        buffer.resize((size_t) capacity, 0.f);
+        writeIndex = 0;
+    }
+    
+    void push(const float* samples, int numSamples)
+    {
+        const auto capacity = getCapacity();
+        
+        // a block bigger than the whole buffer only leaves its tail behind
+        if (numSamples > capacity)
+        {
+            samples += numSamples - capacity;
+            numSamples = capacity;
+        }
+        
+        auto first = juce::jmin(numSamples, capacity - writeIndex);
+        std::copy(samples, samples + first, buffer.begin() + writeIndex);
+        std::copy(samples + first, samples + numSamples, buffer.begin());
+        
+        writeIndex = (writeIndex + numSamples) % capacity;
+    }
+    
+    // copies the newest numSamples samples into dest, oldest first
+    void copyLatest(float* dest, int numSamples) const
+    {
+        const auto capacity = getCapacity();
+        jassert( numSamples <= capacity );
+        
+        auto start = (writeIndex - numSamples + capacity) % capacity;
+        auto first = juce::jmin(numSamples, capacity - start);
+        
+        std::copy(buffer.begin() + start, buffer.begin() + start + first, dest);
+        std::copy(buffer.begin(), buffer.begin() + (numSamples - first), dest + first);
+    }
+    
+    int getCapacity() const { return (int) buffer.size(); }
+private:
+    std::vector<float> buffer;
+    int writeIndex = 0;
+};
+
+// the spectra the analyzer can draw. mid = (L + R) / 2, side = (L - R) / 2
+enum Spectrum
+{
+    LeftSpectrum,
+    RightSpectrum,
+    MidSpectrum,
+    SideSpectrum,
+    NumSpectra
+};
+
+enum SpectrumSmoothing
+{
+    NoSmoothing,
+    ThirdOctave,
+    SixthOctave,
+    TwelfthOctave
+};
+
+/*
+ fractional-octave smoothing of an FFT power spectrum. each bin becomes the mean power
+ of the bins within +-1/2 of the smoothing width (in octaves) around it. the means come
+ from a prefix sum, so the cost is O(numBins) however wide the window is.
+ the window edges, in bins, only depend on the FFT size and the smoothing width, not on
+ the sample rate, and are rebuilt only when either changes
+ */
+struct FractionalOctaveSmoother
+{
+    void prepare(int maxNumBins)
+    {
+        edges.clear();
+        edges.reserve((size_t) maxNumBins);
+        prefixSums.assign((size_t) maxNumBins + 1, 0.0);
+        numEdgeBins = 0;
+    }
+    
+    void setSmoothing(SpectrumSmoothing newSmoothing, int numBins)
+    {
+        if ( newSmoothing == smoothing && numBins == numEdgeBins )
+            return;
+        
+        smoothing = newSmoothing;
+        numEdgeBins = numBins;
+        edges.clear();
+        
+        if ( smoothing == NoSmoothing )
+            return;
+        
+        auto octaves = smoothing == ThirdOctave ? 1.0 / 3.0
+                     : smoothing == SixthOctave ? 1.0 / 6.0
+                     :                            1.0 / 12.0;
+        
+        const auto lowRatio = std::pow(2.0, -octaves * 0.5);
+        const auto highRatio = std::pow(2.0, octaves * 0.5);
+        
+        jassert( (size_t) numBins <= edges.capacity() );
+        
+        for ( int k = 0; k < numBins; ++k )
+        {
+            auto low = juce::jlimit(0, k, (int) std::ceil(k * lowRatio));
+            auto high = juce::jlimit(k, numBins - 1, (int) std::floor(k * highRatio));
+            edges.push_back({ low, high + 1 });
+        }
+    }
+    
+    // smooths power[0, numBins) in place
+    void process(float* power, int numBins)
+    {
+        if ( smoothing == NoSmoothing || numBins != numEdgeBins )
+            return;
+        
+        // doubles, so the differences of large sums don't lose the quiet bins
+        prefixSums[0] = 0.0;
+        for ( int k = 0; k < numBins; ++k )
+            prefixSums[k + 1] = prefixSums[k] + power[k];
+        
+        for ( int k = 0; k < numBins; ++k )
+        {
+            auto edge = edges[k];
+            power[k] = (float) ((prefixSums[edge.second] - prefixSums[edge.first]) / (edge.second - edge.first));
+        }
+    }
+private:
+    SpectrumSmoothing smoothing = NoSmoothing;
+    int numEdgeBins = 0;
+    std::vector<std::pair<int, int>> edges; // [first, end) bins for each bin
+    std::vector<double> prefixSums;
+};
+
+// how the frames produced between two UI ticks are merged into the one that gets drawn
+enum FrameMerge
+{
+    MergeLatest,
+    MergeMax,
+    MergeAverage
+};
+
+/*
+ merges every FFT frame of one spectrum produced since the last takeFrame() into one,
+ so only a single path per UI tick has to be built no matter how many FFTs ran.
+ frames are merged as power (|X|^2) and only converted to dB once, in takeFrame(),
+ so MergeAverage is the mean power over the tick rather than the mean of dB values
+ */
+struct SpectrumAccumulator
+{
+    void prepare(int maxNumBins)
+    {
+        values.assign((size_t) maxNumBins, 0.f);
+        numBins = 0;
+        numFrames = 0;
+    }
+    
+    void add(const float* power, int num, FrameMerge merge)
+    {
+        jassert( num <= (int) values.size() );
+        num = juce::jmin(num, (int) values.size());
+        
+        if ( numFrames == 0 || num != numBins || merge == MergeLatest )
+        {
+            juce::FloatVectorOperations::copy(values.data(), power, num);
+            numBins = num;
+            numFrames = 1;
+            return;
+        }
+        
+        // the loudest power is also the loudest in dB, so max can be taken before the conversion
+        if ( merge == MergeMax )
+            juce::FloatVectorOperations::max(values.data(), values.data(), power, num);
+        else
+            juce::FloatVectorOperations::add(values.data(), power, num);
+        
+        ++numFrames;
+    }
+    
+    /*
+     converts the merged spectrum to dB (power * scale, see powerToDecibels()), quantises it
+     into frame and starts a new one. false if nothing arrived
+     */
+    template<typename FrameType>
+    bool takeFrame(FrameType& frame, FrameMerge merge, float scale, float negativeInfinity)
+    {
+        if ( numFrames == 0 )
+            return false;
+        
+        if ( merge == MergeAverage )
+            scale /= (float) numFrames;
+        
+        // in place, the next add() starts over from a copy anyway
+        powerToDecibels(values.data(), values.data(), numBins, scale, negativeInfinity);
+        
+        frame.quantise(values.data(), numBins, negativeInfinity);
+        numFrames = 0;
+        return true;
+    }
+    
+    int getNumBins() const { return numBins; }
+    int getNumFrames() const { return numFrames; }
+private:
+    std::vector<float> values;
+    int numBins = 0, numFrames = 0;
+};
+
+/*
+ stereo FFT using the real-pair trick: left goes into the real part and right into
+ the imaginary part of one complex FFT, and the two spectra are separated afterwards with
+     L[k] = (Z[k] + conj(Z[N-k])) / 2
+     R[k] = (Z[k] - conj(Z[N-k])) / 2i
+ so both channels cost a single transform. mid/side are linear combinations of L[k] and R[k]
+ and come for free from the same transform.
+ */
+template<typename FrameType>
+struct FFTDataGenerator
+{
+    //produces teh FFT data from the latest fftSize samples of both analysis buffers
+    void produceFFTDataForRendering( const AnalysisRingBuffer& leftAudioData,
+                                     const AnalysisRingBuffer& rightAudioData,
+                                     bool midSide)
+    {
+        using Complex = juce::dsp::Complex<float>;
+        
+        const auto fftSize = getFFTSize();
+        
+        leftAudioData.copyLatest(leftData.data(), fftSize);
+        rightAudioData.copyLatest(rightData.data(), fftSize);
+        
+        //first apply a windowing function to our data
+        window->multiplyWithWindowingTable (leftData.data(), fftSize);       //[1]
+        window->multiplyWithWindowingTable (rightData.data(), fftSize);
+        
+        // pack the channels into one complex signal
+        for (int i = 0; i < fftSize; ++i)
+        {
+            timeData[i] = Complex(leftData[i], rightData[i]);
+        }
+        
+        //then render our FFT data
+        forwardFFT->perform (timeData.data(), spectrumData.data(), false);  //[2]
+        
+        int numBins = (int) fftSize / 2;
+        
+        auto& first = powers[0];
+        auto& second = powers[1];
+        
+        // separate the spectra as power, no sqrt needed since the dB kernel works on |X|^2
+        separateRealPairPowers(spectrumData.data(), fftSize, midSide, first.data(), second.data());
+        
+        smoother.setSmoothing(smoothing, numBins);
+        smoother.process(first.data(), numBins);
+        smoother.process(second.data(), numBins);
+        
+        // only the bins we draw are kept, merged with the other frames since the last tick.
+        // they're normalised and converted to dB once per tick, in getFFTData()
+        accumulators[midSide ? MidSpectrum : LeftSpectrum].add(first.data(), numBins, frameMerge);
+        accumulators[midSide ? SideSpectrum : RightSpectrum].add(second.data(), numBins, frameMerge);
+    }
+    
+    /*
+     builds the FFT plans and windows for every supported order and sizes every buffer
+     for the largest one, so changeOrder() and changeWindow() never allocate.
+     */
+    void prepare()
+    {
+        for (int i = 0; i < numFFTOrders; ++i)
+        {
+            auto fftOrder = minFFTOrder + i;
+            forwardFFTs[i] = std::make_unique<juce::dsp::FFT>(fftOrder);
+            
+            for (int w = 0; w < NumAnalyzerWindows; ++w)
+            {
+                windows[i][w] = std::make_unique<juce::dsp::WindowingFunction<float>>(1 << fftOrder,
+                                                                                        getWindowingMethod(static_cast<AnalyzerWindow>(w)));
+            }
+        }
+        
+        const auto maxFFTSize = 1 << maxFFTOrder;
+        
+        leftData.assign(maxFFTSize, 0.f);
+        rightData.assign(maxFFTSize, 0.f);
+        timeData.assign(maxFFTSize, {});
+        spectrumData.assign(maxFFTSize, {});
+        
+        for (auto& p : powers)
+            p.assign(maxFFTSize / 2, 0.f);
+        
+        for (auto& accumulator : accumulators)
+            accumulator.prepare(maxFFTSize / 2);
+        
+        smoother.prepare(maxFFTSize / 2);
+        
+        changeOrder(order);
+        changeWindow(analyzerWindow);
+    }
+    
+    // switches between the plans built in prepare()
+    void changeOrder(FFTOrder newOrder)
+    {
+        jassert( minFFTOrder <= newOrder && newOrder <= maxFFTOrder );
+        
+        order = static_cast<FFTOrder>(juce::jlimit((int) minFFTOrder, (int) maxFFTOrder, (int) newOrder));
+        forwardFFT = forwardFFTs[order - minFFTOrder].get();
+        window = windows[order - minFFTOrder][analyzerWindow].get();
+    }
+    
+    void changeWindow(AnalyzerWindow newWindow)
+    {
+        jassert( newWindow < NumAnalyzerWindows );
+        
+        analyzerWindow = newWindow;
+        window = windows[order - minFFTOrder][analyzerWindow].get();
+    }
+    //=============================================================
+    int getFFTSize() const { return 1 << order; }
+    FFTOrder getOrder() const { return order; }
+    AnalyzerWindow getWindow() const { return analyzerWindow; }
+    
+    // the plan and window in use, for other analyses that want to line up with ours
+    juce::dsp::FFT& getFFT() { return *forwardFFT; }
+    juce::dsp::WindowingFunction<float>& getWindowingFunction() { return *window; }
+    
+    void setFrameMerge(FrameMerge newMerge) { frameMerge = newMerge; }
+    void setSmoothing(SpectrumSmoothing newSmoothing) { smoothing = newSmoothing; }
+    //=============================================================
+    // the merge of every frame produced since the last call, false if there were none
+    bool getFFTData(Spectrum spectrum, FrameType& fftFrame, float negativeInfinity)
+    {
+        auto& accumulator = accumulators[spectrum];
+        
+        /*
+         normalises by the number of bins. separateRealPairPowers() gives |2 L[k]|^2 and |2 R[k]|^2
+         (or the same scale for mid and side), and the extra 0.5 takes that factor of 2 back out
+         */
+        const auto normalise = 0.5f / (float) juce::jmax(1, accumulator.getNumBins());
+        
+        return accumulator.takeFrame(fftFrame, frameMerge, normalise * normalise, negativeInfinity);
+    }
+private:
+    FFTOrder order = order2048;
+    AnalyzerWindow analyzerWindow = BlackmanHarris;
+    
+    std::vector<float> leftData, rightData;
+    std::vector<juce::dsp::Complex<float>> timeData, spectrumData;
+    std::array<std::vector<float>, 2> powers;
+    
+    std::array<std::unique_ptr<juce::dsp::FFT>, numFFTOrders> forwardFFTs;
+    std::array<std::array<std::unique_ptr<juce::dsp::WindowingFunction<float>>, NumAnalyzerWindows>, numFFTOrders> windows;
+    
+    // the plan and window in use, owned by the arrays above
+    juce::dsp::FFT* forwardFFT = nullptr;
+    juce::dsp::WindowingFunction<float>* window = nullptr;
+    
+    SpectrumSmoothing smoothing = NoSmoothing;
+    FractionalOctaveSmoother smoother;
+    
+    FrameMerge frameMerge = MergeLatest;
+    std::array<SpectrumAccumulator, NumSpectra> accumulators;
+};
+
+// what the transfer function measurement can draw
+enum MeasurementTrace
+{
+    MagnitudeTrace,
+    CoherenceTrace,
+    NumMeasurementTraces
+};
+
+/*
+ measures the EQ's transfer function from its input x and output y:
+     H = Sxy / Sxx,    coherence = |Sxy|^2 / (Sxx * Syy)
+ where Sxx, Syy and Sxy are the auto and cross spectra averaged over frames. coherence
+ says how much of the output the input explains: 1 for a clean linear system, less where
+ noise or too little input energy makes H unreliable.
+ x and y are packed into one complex FFT, the same trick the analyzer plays on left and right,
+ using the analyzer's own plan and window, so a measurement costs one extra FFT per hop.
+ */
+template<typename FrameType>
+struct TransferFunctionAnalyzer
+{
+    // the average is a plain mean until this many frames are in, then exponential over about as many
+    static constexpr int averagingFrames = 16;
+    
+    void prepare()
+    {
+        const auto maxFFTSize = 1 << maxFFTOrder;
+        
+        inputData.assign(maxFFTSize, 0.f);
+        outputData.assign(maxFFTSize, 0.f);
+        timeData.assign(maxFFTSize, {});
+        spectrumData.assign(maxFFTSize, {});
+        
+        inputPower.assign(maxFFTSize / 2, 0.f);
+        outputPower.assign(maxFFTSize / 2, 0.f);
+        crossSpectrum.assign(maxFFTSize / 2, {});
+        scratch.assign(maxFFTSize / 2, 0.f);
+        
+        reset();
+    }
+    
+    // forget the averages, e.g. when the bins change meaning
+    void reset()
+    {
+        std::fill(inputPower.begin(), inputPower.end(), 0.f);
+        std::fill(outputPower.begin(), outputPower.end(), 0.f);
+        std::fill(crossSpectrum.begin(), crossSpectrum.end(), juce::dsp::Complex<float>());
+        numFramesAveraged = 0;
+        numBins = 0;
+        traceIsNew.fill(false);
+    }
+    
+    // adds the latest window of both ring buffers to the averages
+    void process(const AnalysisRingBuffer& input,
+                 const AnalysisRingBuffer& output,
+                 juce::dsp::FFT& fft,
+                 juce::dsp::WindowingFunction<float>& window)
+    {
+        using Complex = juce::dsp::Complex<float>;
+        
+        const auto fftSize = fft.getSize();
+        
+        // a different plan means different bins, the old averages are meaningless
+        if ( fftSize / 2 != numBins )
+        {
+            reset();
+            numBins = fftSize / 2;
+        }
+        
+        input.copyLatest(inputData.data(), fftSize);
+        output.copyLatest(outputData.data(), fftSize);
+        
+        window.multiplyWithWindowingTable(inputData.data(), (size_t) fftSize);
+        window.multiplyWithWindowingTable(outputData.data(), (size_t) fftSize);
+        
+        for (int i = 0; i < fftSize; ++i)
+            timeData[i] = Complex(inputData[i], outputData[i]);
+        
+        fft.perform(timeData.data(), spectrumData.data(), false);
+        
+        if ( numFramesAveraged < averagingFrames )
+            ++numFramesAveraged;
+        
+        const auto alpha = 1.f / (float) numFramesAveraged;
+        
+        for (int k = 0; k < numBins; ++k)
+        {
+            // 2 * X[k] and 2 * Y[k], the 2s cancel in H and the coherence
+            auto z = spectrumData[k];
+            auto zMirror = std::conj(spectrumData[(fftSize - k) & (fftSize - 1)]);
+            
+            auto x = z + zMirror;
+            auto difference = z - zMirror;
+            auto y = Complex(difference.imag(), -difference.real());
+            
+            inputPower[k] += alpha * (std::norm(x) - inputPower[k]);
+            outputPower[k] += alpha * (std::norm(y) - outputPower[k]);
+            crossSpectrum[k] += alpha * (std::conj(x) * y - crossSpectrum[k]);
+        }
+        
+        traceIsNew.fill(true);
+    }
+    
+    /*
+     the trace as a frame, if anything was averaged in since it was last taken.
+     magnitude spans the response curve's -24dB..+24dB, coherence spans 0..1, both
+     mapped onto the frame's [negativeInfinity, 0] so the path generator draws them as they are
+     */
+    bool getFFTData(MeasurementTrace trace, FrameType& frame, float negativeInfinity)
+    {
+        if ( ! traceIsNew[trace] || numBins == 0 )
+            return false;
+        
+        traceIsNew[trace] = false;
+        
+        // keeps bins without any input energy at the bottom instead of dividing by zero
+        constexpr float tiny = 1.0e-20f;
+        
+        if ( trace == MagnitudeTrace )
+        {
+            // |H|^2 = |Sxy|^2 / Sxx^2, shifted down by the +24dB top of the range
+            for (int k = 0; k < numBins; ++k)
+                scratch[k] = std::norm(crossSpectrum[k]) / (inputPower[k] * inputPower[k] + tiny);
+            
+            powerToDecibels(scratch.data(), scratch.data(), numBins, std::pow(10.f, -24.f / 10.f), negativeInfinity);
+        }
+        else
+        {
+            for (int k = 0; k < numBins; ++k)
+            {
+                auto coherence = std::norm(crossSpectrum[k]) / (inputPower[k] * outputPower[k] + tiny);
+                scratch[k] = (1.f - juce::jmin(coherence, 1.f)) * negativeInfinity;
+            }
+        }
+        
+        frame.quantise(scratch.data(), numBins, negativeInfinity);
+        return true;
+    }
+private:
+    std::vector<float> inputData, outputData, scratch;
+    std::vector<juce::dsp::Complex<float>> timeData, spectrumData;
+    
+    std::vector<float> inputPower, outputPower;
+    std::vector<juce::dsp::Complex<float>> crossSpectrum;
+    
+    int numBins = 0;
+    int numFramesAveraged = 0;
+    std::array<bool, NumMeasurementTraces> traceIsNew {};
+};
+
+/*
+ multi-resolution stereo analyzer: a cascade of numStages octave stages. stage 0 sees the
+ full rate, every following stage gets the previous one lowpassed (8th order Butterworth)
+ and decimated by 2. every stage runs the same small real-pair FFT, so the bins get twice
+ as narrow with each stage while the FFT size stays the same.
+ 
+ each stage only contributes the octave [rate / 8, rate / 4) of its own rate, well below
+ its decimation filter's aliasing (stage 0 also gives everything above, the last stage
+ everything below). stitched together that is one log-frequency spectrum with
+ fs / 2^(numStages - 1) / stageFFTSize bins at the bottom: ~1.5Hz at 48kHz, vs 5.9Hz at order 8192.
+ 
+ stage s runs an FFT every stageHopSize samples of its own rate, so the FFT rate halves with
+ every stage and all stages together cost ~2 stage FFTs per hop of stage 0. with
+ 1024 point FFTs every 512 samples that's about the cost of one 2048 point FFT every 512 samples
+ */
+template<typename FrameType>
+struct MultiResolutionAnalyzer
+{
+    static constexpr int numStages = 6;
+    static constexpr int stageOrder = 10;
+    static constexpr int stageFFTSize = 1 << stageOrder;
+    static constexpr int stageHopSize = stageFFTSize / 2;
+    static constexpr int stageNumBins = stageFFTSize / 2;
+    
+    // input is handled in chunks of at most this many samples, which bounds the stage scratch buffers
+    static constexpr int maxChunkSize = 512;
+    
+    void prepare()
+    {
+        forwardFFT = std::make_unique<juce::dsp::FFT>(stageOrder);
+        
+        for (int w = 0; w < NumAnalyzerWindows; ++w)
+            windows[w] = std::make_unique<juce::dsp::WindowingFunction<float>>(stageFFTSize, getWindowingMethod(static_cast<AnalyzerWindow>(w)));
+        
+        leftData.assign(stageFFTSize, 0.f);
+        rightData.assign(stageFFTSize, 0.f);
+        timeData.assign(stageFFTSize, {});
+        spectrumData.assign(stageFFTSize, {});
+        first.assign(stageNumBins, 0.f);
+        second.assign(stageNumBins, 0.f);
+        
+        // the cutoff relative to the rate is the same at every stage, so one design serves them all.
+        // 0.15 * rate keeps the used octave (up to rate / 8) flat and is ~64dB down where aliases would fold into it
+        auto lowpass = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(0.15f * 48000.f, 48000.0, 8);
+        
+        for (auto& stage : stages)
+        {
+            stage.left.prepare(stageFFTSize);
+            stage.right.prepare(stageFFTSize);
+            stage.samplesUntilNextFFT = stageHopSize;
+            
+            for (auto& d : stage.decibels)
+                d.assign(stageNumBins, -48.f);
+            
+            for (size_t i = 0; i < stage.leftFilters.size(); ++i)
+            {
+                stage.leftFilters[i].coefficients = lowpass[(int) i];
+                stage.rightFilters[i].coefficients = lowpass[(int) i];
+                stage.leftFilters[i].reset();
+                stage.rightFilters[i].reset();
+            }
+            
+            stage.leftDecimated.assign(maxChunkSize, 0.f);
+            stage.rightDecimated.assign(maxChunkSize, 0.f);
+            stage.keepNextSample = true;
+        }
+        
+        // ascending frequency order: the last stage's bins first
+        int numStitchedBins = 0;
+        for (int s = 0; s < numStages; ++s)
+            numStitchedBins += getStageEndBin(s) - getStageFirstBin(s);
+        
+        stitched.assign((size_t) numStitchedBins, -48.f);
+        binFrequencies.assign((size_t) numStitchedBins, 0.f);
+        sampleRate = 0.0;
+    }
+    
+    // rebuilds the stitched bin frequencies if the rate changed
+    void setSampleRate(double newSampleRate)
+    {
+        if ( newSampleRate == sampleRate )
+            return;
+        
+        sampleRate = newSampleRate;
+        ++layoutId;
+        
+        size_t i = 0;
+        for (int s = numStages - 1; s >= 0; --s)
+        {
+            auto binWidth = (float) (sampleRate / (double) (1 << s) / (double) stageFFTSize);
+            
+            for (int bin = getStageFirstBin(s); bin < getStageEndBin(s); ++bin)
+                binFrequencies[i++] = bin * binWidth;
+        }
+    }
+    
+    void setWindow(AnalyzerWindow newWindow) { analyzerWindow = newWindow; }
+    
+    void process(const float* leftSamples, const float* rightSamples, int numSamples, bool midSide, float negativeInfinity)
+    {
+        while ( numSamples > 0 )
+        {
+            auto chunk = juce::jmin(numSamples, maxChunkSize);
+            processStage(0, leftSamples, rightSamples, chunk, midSide, negativeInfinity);
+            
+            leftSamples += chunk;
+            rightSamples += chunk;
+            numSamples -= chunk;
+        }
+    }
+    
+    // the stitched spectrum, if any stage produced a new frame for it since the last call
+    bool getFFTData(Spectrum spectrum, FrameType& fftFrame, float negativeInfinity)
+    {
+        if ( ! isNew[spectrum] )
+            return false;
+        
+        isNew[spectrum] = false;
+        
+        size_t i = 0;
+        for (int s = numStages - 1; s >= 0; --s)
+        {
+            auto& decibels = stages[(size_t) s].decibels[spectrum];
+            
+            for (int bin = getStageFirstBin(s); bin < getStageEndBin(s); ++bin)
+                stitched[i++] = decibels[(size_t) bin];
+        }
+        
+        fftFrame.quantise(stitched.data(), (int) stitched.size(), negativeInfinity);
+        return true;
+    }
+    
+    const std::vector<float>& getBinFrequencies() const { return binFrequencies; }
+    int getLayoutId() const { return layoutId; }
+private:
+    struct Stage
+    {
+        AnalysisRingBuffer left, right;
+        int samplesUntilNextFFT = stageHopSize;
+        
+        // latest spectrum of this stage, for every Spectrum
+        std::array<std::vector<float>, NumSpectra> decibels;
+        
+        // lowpass + decimation feeding the next stage
+        std::array<juce::dsp::IIR::Filter<float>, 4> leftFilters, rightFilters;
+        std::vector<float> leftDecimated, rightDecimated;
+        bool keepNextSample = true;
+    };
+    
+    std::array<Stage, numStages> stages;
+    
+    std::unique_ptr<juce::dsp::FFT> forwardFFT;
+    std::array<std::unique_ptr<juce::dsp::WindowingFunction<float>>, NumAnalyzerWindows> windows;
+    AnalyzerWindow analyzerWindow = BlackmanHarris;
+    
+    std::vector<float> leftData, rightData, first, second;
+    std::vector<juce::dsp::Complex<float>> timeData, spectrumData;
+    
+    std::vector<float> stitched, binFrequencies;
+    double sampleRate = 0.0;
+    int layoutId = 0;
+    std::array<bool, NumSpectra> isNew {};
+    
+    static int getStageFirstBin(int s) { return s == numStages - 1 ? 1 : stageNumBins / 4; }
+    static int getStageEndBin(int s) { return s == 0 ? stageNumBins : stageNumBins / 2; }
+    
+    void processStage(int s, const float* leftSamples, const float* rightSamples, int numSamples, bool midSide, float negativeInfinity)
+    {
+        auto& stage = stages[(size_t) s];
+        
+        // same hop splitting as PathProducer, at this stage's rate
+        for (int pos = 0; pos < numSamples; )
+        {
+            auto numToWrite = juce::jmin(numSamples - pos, stage.samplesUntilNextFFT);
+            stage.left.push(leftSamples + pos, numToWrite);
+            stage.right.push(rightSamples + pos, numToWrite);
+            
+            pos += numToWrite;
+            stage.samplesUntilNextFFT -= numToWrite;
+            
+            if ( stage.samplesUntilNextFFT == 0 )
+            {
+                runStageFFT(stage, midSide, negativeInfinity);
+                stage.samplesUntilNextFFT = stageHopSize;
+            }
+        }
+        
+        if ( s + 1 == numStages )
+            return;
+        
+        // lowpass and keep every other sample for the next stage
+        int numDecimated = 0;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto l = leftSamples[i];
+            auto r = rightSamples[i];
+            
+            for (size_t f = 0; f < stage.leftFilters.size(); ++f)
+            {
+                l = stage.leftFilters[f].processSample(l);
+                r = stage.rightFilters[f].processSample(r);
+            }
+            
+            if ( stage.keepNextSample )
+            {
+                stage.leftDecimated[(size_t) numDecimated] = l;
+                stage.rightDecimated[(size_t) numDecimated] = r;
+                ++numDecimated;
+            }
+            
+            stage.keepNextSample = ! stage.keepNextSample;
+        }
+        
+        if ( numDecimated > 0 )
+            processStage(s + 1, stage.leftDecimated.data(), stage.rightDecimated.data(), numDecimated, midSide, negativeInfinity);
+    }
+    
+    void runStageFFT(Stage& stage, bool midSide, float negativeInfinity)
+    {
+        stage.left.copyLatest(leftData.data(), stageFFTSize);
+        stage.right.copyLatest(rightData.data(), stageFFTSize);
+        
+        auto& window = *windows[analyzerWindow];
+        window.multiplyWithWindowingTable(leftData.data(), stageFFTSize);
+        window.multiplyWithWindowingTable(rightData.data(), stageFFTSize);
+        
+        for (int i = 0; i < stageFFTSize; ++i)
+            timeData[(size_t) i] = juce::dsp::Complex<float>(leftData[(size_t) i], rightData[(size_t) i]);
+        
+        forwardFFT->perform(timeData.data(), spectrumData.data(), false);
+        
+        separateRealPairPowers(spectrumData.data(), stageFFTSize, midSide, first.data(), second.data());
+        
+        const auto normalise = 0.5f / (float) stageNumBins;
+        auto firstSpectrum = midSide ? MidSpectrum : LeftSpectrum;
+        auto secondSpectrum = midSide ? SideSpectrum : RightSpectrum;
+        
+        powerToDecibels(first.data(), stage.decibels[firstSpectrum].data(), stageNumBins, normalise * normalise, negativeInfinity);
+        powerToDecibels(second.data(), stage.decibels[secondSpectrum].data(), stageNumBins, normalise * normalise, negativeInfinity);
+        
+        isNew[firstSpectrum] = true;
+        isNew[secondSpectrum] = true;
+    }
+};
+
+/*
+ which bins land in which pixel column of the analysis area.
+ only rebuilt when the width, FFT size or bin width (sample rate) changes
+ */
+struct BinToColumnMap
+{
+    struct Column
+    {
+        int x;
+        int firstBin, endBin; // [firstBin, endBin)
+    };
+    
+    // evenly spaced FFT bins. returns true if the map had to be rebuilt
+    bool update(int width, int fftSize, float binWidth)
+    {
+        if ( width == lastWidth && fftSize == lastFFTSize && binWidth == lastBinWidth && lastLayoutId < 0 )
+            return false;
+        
+        lastWidth = width;
+        lastFFTSize = fftSize;
+        lastBinWidth = binWidth;
+        lastLayoutId = -1;
+        
+        rebuild(width, fftSize / 2, [binWidth](int binNum) { return binNum * binWidth; });
+        return true;
+    }
+    
+    /*
+     bins at arbitrary (ascending) frequencies, like the stitched multi-resolution spectrum.
+     layoutId has to change whenever binFrequencies does
+     */
+    bool update(int width, const std::vector<float>& binFrequencies, int layoutId)
+    {
+        if ( width == lastWidth && layoutId == lastLayoutId )
+            return false;
+        
+        lastWidth = width;
+        lastFFTSize = -1;
+        lastBinWidth = -1.f;
+        lastLayoutId = layoutId;
+        
+        rebuild(width, (int) binFrequencies.size(), [&binFrequencies](int binNum) { return binFrequencies[(size_t) binNum]; });
+        return true;
+    }
+    
+    const std::vector<Column>& getColumns() const { return columns; }
+private:
+    std::vector<Column> columns;
+    int lastWidth = -1, lastFFTSize = -1, lastLayoutId = -1;
+    float lastBinWidth = -1.f;
+    
+    template<typename BinFrequencyFunction>
+    void rebuild(int width, int numBins, BinFrequencyFunction getBinFrequency)
+    {
+        columns.clear();
+        columns.reserve((size_t) juce::jmax(0, width));
+        
+        // bins are monotonic in x, so every column is one contiguous run of bins.
+        // bins below 20Hz fold into the first column, bins above 20kHz are off the right edge
+        for ( int binNum = 1; binNum < numBins; ++binNum )
+        {
+            auto binFreq = getBinFrequency(binNum);
+            auto normalizedBinX = juce::mapFromLog10(juce::jmax(binFreq, 20.f), 20.f, 20000.f);
+            int binX = (int) std::floor(normalizedBinX * width);
+            
+            if ( binX >= width )
+                break;
+            
+            if ( ! columns.empty() && columns.back().x == binX )
+                columns.back().endBin = binNum + 1;
+            else
+                columns.push_back({ binX, binNum, binNum + 1 });
+        }
+    }
+};
+
+// class to take FFTData, bounding box, FFT size, bin width and spit out a path
+template<typename PathType>
+struct AnalyzerPathGenerator
+{
+    /*
+     converts 'renderData[] into p, in the coordinates of fftBounds, with one point per
+     pixel column (the loudest bin in it) whatever the FFT size. p is cleared first but keeps its storage, so
+     reusing the same path every frame doesn't allocate.
+     returns false (and leaves p alone) if the frame is empty
+     */
+    template<typename FrameType>
+    bool generatePath(const FrameType& renderData,
+                      juce::Rectangle<float> fftBounds,
+                      int fftSize,
+                      float binWidth,
+                      PathType& p)
+    {
+        int numBins = juce::jmin((int)fftSize / 2, renderData.getNumBins());
+        
+        if( numBins == 0 )
+            return false;
+        
+        binToColumnMap.update((int) fftBounds.getWidth(), fftSize, binWidth);
+        buildPath(renderData, numBins, fftBounds, p);
+        return true;
+    }
+    
+    // same, for frames whose bins sit at the given frequencies (see BinToColumnMap)
+    template<typename FrameType>
+    bool generatePath(const FrameType& renderData,
+                      juce::Rectangle<float> fftBounds,
+                      const std::vector<float>& binFrequencies,
+                      int layoutId,
+                      PathType& p)
+    {
+        int numBins = juce::jmin((int) binFrequencies.size(), renderData.getNumBins());
+        
+        if( numBins == 0 )
+            return false;
+        
+        binToColumnMap.update((int) fftBounds.getWidth(), binFrequencies, layoutId);
+        buildPath(renderData, numBins, fftBounds, p);
+        return true;
+    }
+private:
+    BinToColumnMap binToColumnMap;
+    
+    template<typename FrameType>
+    void buildPath(const FrameType& renderData, int numBins, juce::Rectangle<float> fftBounds, PathType& p)
+    {
+        auto left = fftBounds.getX();
+        auto top = fftBounds.getY();
+        auto bottom = fftBounds.getBottom();
+        auto width = (int) fftBounds.getWidth();
+        
+        p.clear();
+        p.preallocateSpace(3 * (width + 1));
+        
+        // codes are linear in dB, so they map straight onto the display range
+        auto* codes = renderData.getCodes();
+        auto map = [bottom, top](float code)
+        {
+            return juce::jmap(code,
+                              0.f, FrameType::maxCode,
+                              float(bottom), top);
+        };
+        
+        auto y = map(codes[0]);
+        
+        jassert( !std::isnan(y) && !std::isinf(y) );
+        
+        p.startNewSubPath(left, y);
+        
+        for( const auto& column : binToColumnMap.getColumns() )
+        {
+            if( column.firstBin >= numBins )
+                break;
+            
+            auto endBin = juce::jmin(column.endBin, numBins);
+            auto peak = *std::max_element(codes + column.firstBin, codes + endBin);
+            
+            p.lineTo(left + column.x, map(peak));
+        }
+    }
+};
+
+/*
+ turns a frame into one spectrogram column: a level (0 - 255, linear in dB) per pixel row,
+ row 0 at 20kHz. it's the BinToColumnMap turned on its side, so rows between two bins
+ (the low end) are interpolated from the bins either side of them
+ */
+struct SpectrogramColumnGenerator
+{
+    template<typename FrameType>
+    bool generateColumn(const FrameType& renderData,
+                        int numRows,
+                        int fftSize,
+                        float binWidth,
+                        std::vector<uint8_t>& levels)
+    {
+        int numBins = juce::jmin(fftSize / 2, renderData.getNumBins());
+        
+        if( numBins == 0 || numRows <= 0 )
+            return false;
+        
+        binToRowMap.update(numRows, fftSize, binWidth);
+        buildColumn(renderData, numBins, numRows, levels);
+        return true;
+    }
+    
+    template<typename FrameType>
+    bool generateColumn(const FrameType& renderData,
+                        int numRows,
+                        const std::vector<float>& binFrequencies,
+                        int layoutId,
+                        std::vector<uint8_t>& levels)
+    {
+        int numBins = juce::jmin((int) binFrequencies.size(), renderData.getNumBins());
+        
+        if( numBins == 0 || numRows <= 0 )
+            return false;
+        
+        binToRowMap.update(numRows, binFrequencies, layoutId);
+        buildColumn(renderData, numBins, numRows, levels);
+        return true;
+    }
+private:
+    BinToColumnMap binToRowMap;
+    
+    template<typename FrameType>
+    void buildColumn(const FrameType& renderData, int numBins, int numRows, std::vector<uint8_t>& levels)
+    {
+        // same size every frame once the height settles, so this doesn't reallocate
+        levels.resize((size_t) numRows);
+        
+        auto* codes = renderData.getCodes();
+        auto toLevel = [](float code) { return code * (255.f / FrameType::maxCode); };
+        
+        // the map counts up from 20Hz, rows count down from 20kHz
+        auto setRow = [&levels, numRows](int x, float level)
+        {
+            levels[(size_t) (numRows - 1 - x)] = (uint8_t) juce::jlimit(0, 255, (int) (level + 0.5f));
+        };
+        
+        int nextX = 0;
+        float lastLevel = -1.f;
+        
+        for( const auto& column : binToRowMap.getColumns() )
+        {
+            if( column.firstBin >= numBins )
+                break;
+            
+            auto endBin = juce::jmin(column.endBin, numBins);
+            auto level = toLevel((float) *std::max_element(codes + column.firstBin, codes + endBin));
+            
+            // nothing below the first bin to interpolate from
+            if( lastLevel < 0.f )
+                lastLevel = level;
+            
+            auto gap = column.x - nextX + 1;
+            for( int x = nextX; x < column.x; ++x )
+                setRow(x, juce::jmap(float(x - nextX + 1), 0.f, float(gap), lastLevel, level));
+            
+            setRow(column.x, level);
+            nextX = column.x + 1;
+            lastLevel = level;
+        }
+        
+        // above the last bin (or above nyquist)
+        for( int x = nextX; x < numRows; ++x )
+            setRow(x, 0.f);
+    }
+};
+
+struct LookAndFeel : juce::LookAndFeel_V4
+{
+    void drawRotarySlider (juce::Graphics&,
+                           int x, int y, int width, int height,
+                           float sliderPosProportional,
+                           float rotaryStartAngle,
+                           float rotaryEndAngle,
+                           juce::Slider&) override;
+    
+    void drawToggleButton (juce::Graphics &g,
+                           juce::ToggleButton & toggleButton,
+                           bool shouldDrawButtonAsHighlighted,
+                           bool shouldDrawButtonAsDown) override;
+    
+};
+
+struct RotarySliderWithLabels : juce::Slider
+{
+    RotarySliderWithLabels(juce::RangedAudioParameter& rap, const juce::String& unitSuffix) :                                                                   juce::Slider(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag,
+                                        juce::Slider::TextEntryBoxPosition::NoTextBox),
+                                        param(&rap),
+                                        suffix(unitSuffix)
+    {
+        setLookAndFeel(lnf.get());
+    }
+    
+    ~RotarySliderWithLabels()
+    {
+        setLookAndFeel(nullptr);
+    }
+    
+    struct LabelPos
+    {
+        float pos;
+        juce::String label;
+    };
+    
+    juce::Array<LabelPos> labels;
+    
+    void paint(juce::Graphics& g) override;
+    juce::Rectangle<int> getSliderBounds() const;
+    int getTextHeight() const {return 14; }
+    juce::String getDisplayString() const;
+    
+private:
+    // one for every slider in every open editor
+    juce::SharedResourcePointer<LookAndFeel> lnf;
+    
+    juce::RangedAudioParameter* param;
+    juce::String suffix;
+};
+
+/*
+ records analyzer frames into capture files, the format is in SpectrumCaptureFormat.h.
+ files are created, preallocated, memory mapped and finished by a job on the analysis thread
+ pool, which always keeps a spare one ready, so neither the message thread nor the analyzer
+ waits for the disk. the analyzer only copies frames into mapped memory and swaps the spare
+ in when a file is full or the analyzer settings change. if it can't get the lock or there's
+ no spare yet, the frame is dropped and counted
+ */
+struct SpectrumCaptureWriter
+{
+    // ~16 minutes of both 2048 point spectra at 60 frames a second
+    static constexpr juce::int64 fileSizeInBytes = 256 * 1024 * 1024;
+    
+    struct Settings
+    {
+        double sampleRate;
+        int fftSize;
+        AnalyzerWindow window;
+        
+        bool operator==(const Settings& other) const
+        {
+            return sampleRate == other.sampleRate && fftSize == other.fftSize && window == other.window;
+        }
+    };
+    
+    ~SpectrumCaptureWriter() { stop(); }
+    
+    /*
+     message thread. files go into directory, named after the time the capture started, and are
+     made on pool, which has to outlive the writer. returns false if the directory can't be made,
+     a file that can't be made later shows up in hasFailed()
+     */
+    bool start(const juce::File& directory, juce::ThreadPool& pool);
+    
+    // message thread. waits for a file that's being made, then finishes the files
+    void stop();
+    
+    // message thread, every UI tick: queues the file job if a spare is needed or a file is done with
+    void service();
+    
+    bool isCapturing() const { return capturing.load(); }
+    bool hasFailed() const { return failed.load(); }
+    int getNumDroppedFrames() const { return numDroppedFrames.load(); }
+    
+    // analysis thread
+    void write(const Settings& settings, Spectrum spectrum, const FFTFrame& frame, float negativeInfinity);
+private:
+    struct CaptureFile
+    {
+        juce::File file;
+        std::unique_ptr<juce::MemoryMappedFile> map;
+        
+        // what's in the file's header, kept here so the mapped bytes are only ever written
+        SpectrumCaptureFormat::Header header {};
+        
+        unsigned char* getData() { return static_cast<unsigned char*>(map->getData()); }
+    };
+    
+    // current is only touched by the analysis thread, the message thread just moves files in and out
+    juce::SpinLock fileLock;
+    std::unique_ptr<CaptureFile> current, spare, finished;
+    Settings currentSettings {};
+    
+    std::atomic<bool> capturing { false }, failed { false };
+    std::atomic<int> numDroppedFrames { 0 };
+    
+    // set by start() while the job isn't queued, only read by the job after that
+    juce::File captureDirectory;
+    juce::String captureName;
+    int numFilesCreated = 0;
+    double startTimeMs = 0.0;
+    
+    // finishes the finished file and makes a spare if there isn't one
+    struct FileJob : juce::ThreadPoolJob
+    {
+        FileJob(SpectrumCaptureWriter& w) : juce::ThreadPoolJob("SimpleEQ Capture Files"), writer(w) {}
+        
+        JobStatus runJob() override
+        {
+            writer.updateFiles();
+            return jobHasFinished;
+        }
+        
+        SpectrumCaptureWriter& writer;
+    };
+    
+    FileJob fileJob { *this };
+    juce::ThreadPool* filePool = nullptr;
+    
+    void updateFiles();
+    std::unique_ptr<CaptureFile> createFile();
+    static void finishFile(std::unique_ptr<CaptureFile> captureFile);
+};
+
+struct PathProducer
+{
+    using ChannelFifo = SingleChannelSampleFifo<SimpleEQAudioProcessor::BlockType>;
+    
+    // fifoReadLock is held while the fifos are read, see SimpleEQAudioProcessor::analyzerFifoReadLock
+    PathProducer(ChannelFifo& leftScsf, ChannelFifo& rightScsf, ChannelFifo& inputScsf, const juce::CriticalSection& fifoReadLock) :
+    leftChannelFifo(&leftScsf),
+    rightChannelFifo(&rightScsf),
+    inputChannelFifo(&inputScsf),
+    fifoReadLock(fifoReadLock)
+    {
+        // everything is sized for the largest order, switching order or window later doesn't allocate
+        fftDataGenerator.prepare();
+        multiResolutionAnalyzer.prepare();
+        transferFunctionAnalyzer.prepare();
+        leftAnalysisBuffer.prepare(1 << maxFFTOrder);
+        rightAnalysisBuffer.prepare(1 << maxFFTOrder);
+        inputAnalysisBuffer.prepare(1 << maxFFTOrder);
+        fftFrame.prepare((1 << maxFFTOrder) / 2);
+        setOverlap(0.75f);
+    }
+    /*
+     runs on an analysis worker thread. at most fftBudget FFTs are computed per call,
+     further hops are skipped and replaced by one FFT of the newest window.
+     spectrogramRows is the height of the spectrogram column to build, 0 if nobody is showing it
+     */
+    void process(juce::Rectangle<float> fftbounds, double sampleRate, int fftBudget, int spectrogramRows);
+    
+    /*
+     message thread: swaps any paths finished since the last call into displayPaths.
+     nothing is copied or allocated, the paths just trade storage. returns true if
+     anything new arrived
+     */
+    bool pullPaths(std::array<juce::Path, NumSpectra>& displayPaths)
+    {
+        const juce::SpinLock::ScopedLockType lock(pathLock);
+        
+        bool gotNewPath = false;
+        for ( int i = 0; i < NumSpectra; ++i )
+        {
+            if ( pathIsNew[i] )
+            {
+                displayPaths[i].swapWithPath(paths[i]);
+                pathIsNew[i] = false;
+                gotNewPath = true;
+            }
+        }
+        
+        return gotNewPath;
+    }
+    
+    // same as pullPaths, for the transfer function measurement
+    bool pullMeasurementPaths(std::array<juce::Path, NumMeasurementTraces>& displayPaths)
+    {
+        const juce::SpinLock::ScopedLockType lock(pathLock);
+        
+        bool gotNewPath = false;
+        for ( int i = 0; i < NumMeasurementTraces; ++i )
+        {
+            if ( measurementPathIsNew[i] )
+            {
+                displayPaths[i].swapWithPath(measurementPaths[i]);
+                measurementPathIsNew[i] = false;
+                gotNewPath = true;
+            }
+        }
+        
+        return gotNewPath;
+    }
+    
+    /*
+     message thread: swaps the newest spectrogram column into displayColumn, if one was
+     finished since the last call. like pullPaths, only the storage is traded
+     */
+    bool pullSpectrogramColumn(std::vector<uint8_t>& displayColumn)
+    {
+        const juce::SpinLock::ScopedLockType lock(pathLock);
+        
+        if ( ! spectrogramColumnIsNew )
+            return false;
+        
+        displayColumn.swap(spectrogramColumn);
+        spectrogramColumnIsNew = false;
+        return true;
+    }
+    
+    // latest frame, max or average of every frame between two ticks
+    void setFrameMerge(FrameMerge newMerge) { frameMerge.store(newMerge); }
+    
+    // draw mid/side instead of left/right. costs no extra FFT
+    void setMidSide(bool shouldShowMidSide) { midSide.store(shouldShowMidSide); }
+    bool isMidSide() const { return midSide.load(); }
+    
+    /*
+     can be called from the message thread, the worker picks the change up on its next process().
+     orderAuto follows the sample rate
+     */
+    void setFFTOrder(FFTOrder newOrder) { requestedOrder.store(newOrder); }
+    void setWindow(AnalyzerWindow newWindow) { requestedWindow.store(newWindow); }
+    void setSmoothing(SpectrumSmoothing newSmoothing) { smoothing.store(newSmoothing); }
+    
+    // measure the EQ's transfer function (left channel) alongside the analyzer. starts a new average
+    void setMeasuring(bool shouldMeasure) { measuring.store(shouldMeasure); }
+    bool isMeasuring() const { return measuring.load(); }
+    
+    /*
+     an FFT runs every hopSize samples, no matter what block size the host uses.
+     overlap is the fraction of the window shared by consecutive FFTs, 0.75 -> hop of fftSize / 4.
+     call these from the thread running process()
+     */
+    void setHopSize(int newHopSize) { hopSize = juce::jlimit(1, fftDataGenerator.getFFTSize(), newHopSize); samplesUntilNextFFT = hopSize; }
+    void setOverlap(float newOverlap)
+    {
+        overlap = juce::jlimit(0.f, 0.99f, newOverlap);
+        setHopSize(juce::roundToInt(fftDataGenerator.getFFTSize() * (1.f - overlap)));
+    }
+    int getHopSize() const { return hopSize; }
+    
+    // records the merged frame of every spectrum the single FFT analyzer draws each tick, see SpectrumCaptureWriter
+    SpectrumCaptureWriter& getCaptureWriter() { return captureWriter; }
+private:
+    // convert audio samples to FFT data
+    ChannelFifo* leftChannelFifo;
+    ChannelFifo* rightChannelFifo;
+    ChannelFifo* inputChannelFifo;
+    const juce::CriticalSection& fifoReadLock;
+    
+    // blocks pulled from the channel fifos, kept around so pulling doesn't allocate
+    juce::AudioBuffer<float> leftIncomingBuffer, rightIncomingBuffer, inputIncomingBuffer;
+    
+    // last fftSize samples of each channel, written circularly. input is the left channel before the EQ
+    AnalysisRingBuffer leftAnalysisBuffer, rightAnalysisBuffer, inputAnalysisBuffer;
+    int hopSize = 512, samplesUntilNextFFT = 512;
+    float overlap = 0.75f;
+    
+    std::atomic<bool> midSide { false };
+    std::atomic<FrameMerge> frameMerge { MergeLatest };
+    std::atomic<SpectrumSmoothing> smoothing { NoSmoothing };
+    std::atomic<FFTOrder> requestedOrder { orderAuto };
+    std::atomic<AnalyzerWindow> requestedWindow { BlackmanHarris };
+    std::atomic<bool> measuring { false };
+    bool wasMeasuring = false;
+    
+    // whether the input fifo was fed last time, and how much input the measurement still waits for
+    bool hadInput = false;
+    int inputSamplesUntilValid = 0;
+    
+    void applyRequestedSettings(double sampleRate);
+    
+    FFTDataGenerator<FFTFrame> fftDataGenerator;
+    MultiResolutionAnalyzer<FFTFrame> multiResolutionAnalyzer;
+    bool useMultiResolution = false;
+    
+    // always uses the single FFT's plan, also in multi-resolution mode
+    TransferFunctionAnalyzer<FFTFrame> transferFunctionAnalyzer;
+    
+    SpectrumCaptureWriter captureWriter;
+    
+    // preallocated frame that the merged FFT data is copied into
+    FFTFrame fftFrame;
+    
+    std::array<AnalyzerPathGenerator<juce::Path>, NumSpectra> pathGenerators;
+    
+    /*
+     the worker builds into workerPaths and swaps them into paths, the message thread swaps
+     paths into its display copies. every path keeps its storage, so after the first few frames
+     nothing allocates
+     */
+    std::array<juce::Path, NumSpectra> paths, workerPaths;
+    std::array<bool, NumSpectra> pathIsNew {};
+    juce::SpinLock pathLock;
+    
+    std::array<AnalyzerPathGenerator<juce::Path>, NumMeasurementTraces> measurementPathGenerators;
+    std::array<juce::Path, NumMeasurementTraces> measurementPaths, workerMeasurementPaths;
+    std::array<bool, NumMeasurementTraces> measurementPathIsNew {};
+    
+    // one column per tick from the first spectrum (left or mid), handed over the same way as the paths
+    SpectrogramColumnGenerator spectrogramColumnGenerator;
+    std::vector<uint8_t> spectrogramColumn, workerSpectrogramColumn;
+    bool spectrogramColumnIsNew = false;
+    
+    // one hop: the analyzer FFT (unless the multi-resolution bank has it) and the measurement if it's on
+    void runFFT(bool shouldShowMidSide, bool shouldMeasure);
+};
+
+/*
+ one pool of low priority threads shared by every open editor in the process.
+ all editors queue their analyzer jobs on it, and whichever thread is idle takes
+ the next job, so a busy instance never holds up the others.
+ get it through juce::SharedResourcePointer so it lives only while an editor is open.
+ */
+struct AnalysisThreadPool
+{
+    AnalysisThreadPool() :
+    pool(juce::jlimit(1, 4, juce::SystemStats::getNumCpus() / 2), 0, juce::Thread::Priority::low)
+    {
+    }
+    
+    juce::ThreadPool pool;
+};
+
+// one instance's analyzer work, queued on the AnalysisThreadPool once per UI tick
+struct AnalyzerJob : juce::ThreadPoolJob
+{
+    AnalyzerJob(PathProducer& producer) :
+    juce::ThreadPoolJob("SimpleEQ Analyzer"),
+    pathProducer(producer)
+    {
+    }
+    
+    JobStatus runJob() override
+    {
+        pathProducer.process(fftBounds, sampleRate, fftBudget, spectrogramRows);
+        
+        return jobHasFinished;
+    }
+    
+    // only written by the message thread while the job isn't queued
+    juce::Rectangle<float> fftBounds;
+    double sampleRate = 44100.0;
+    int spectrogramRows = 0;
+    
+    // per instance limit on (stereo) FFTs per tick, so one instance can't starve the pool
+    int fftBudget = 8;
+private:
+    PathProducer& pathProducer;
+};
+
+/*
+ scrolling spectrogram. the history lives in an image used as a ring buffer, one pixel
+ column per analyzer frame: a new frame overwrites the oldest column (O(height)) and
+ paint draws the image in two pieces either side of the write position, so nothing
+ is ever redrawn or scrolled
+ */
+struct SpectrogramComponent : juce::Component
+{
+    SpectrogramComponent();
+    
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    
+    // message thread: levels from PathProducer::pullSpectrogramColumn, row 0 at the top
+    void pushColumn(const std::vector<uint8_t>& levels);
+private:
+    // software image, so writing a column is a plain memory write whatever the renderer
+    juce::Image history;
+    
+    // next column to overwrite, which is also the oldest one
+    int writePosition = 0;
+    
+    // level (0 = -48dB, 255 = 0dB) to colour
+    std::array<juce::PixelARGB, 256> colourLookup;
+};
+
+struct ResponseCurveComponent: juce::Component, juce::AudioProcessorParameter::Listener
+{
+    ResponseCurveComponent(SimpleEQAudioProcessor&);
+    ~ResponseCurveComponent();
+    void parameterValueChanged (int parameterIndex, float newValue) override;
+    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override { }
+    
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    
+    void toggleAnalysisEnablement(bool enabled)
+    {
+        shouldShowFFTAnalysis = enabled;
+        repaint();
+    }
+    
+    void toggleMidSideAnalysis(bool enabled)
+    {
+        analyzerSettings.midSide = enabled;
+        applyAnalyzerSettings();
+    }
+    
+    void setAnalyzerOrder(FFTOrder order)
+    {
+        analyzerSettings.order = order;
+        applyAnalyzerSettings();
+    }
+    
+    void setAnalyzerWindow(AnalyzerWindow window)
+    {
+        analyzerSettings.window = window;
+        applyAnalyzerSettings();
+    }
+    
+    void setAnalyzerSmoothing(SpectrumSmoothing smoothing)
+    {
+        analyzerSettings.smoothing = smoothing;
+        applyAnalyzerSettings();
+    }
+    
+    void setAnalyzerFrameMerge(FrameMerge frameMerge)
+    {
+        analyzerSettings.frameMerge = frameMerge;
+        applyAnalyzerSettings();
+    }
+    
+    void toggleMeasurement(bool enabled)
+    {
+        analyzerSettings.measuring = enabled;
+        applyAnalyzerSettings();
+        analyzerLayerIsValid = false;
+        repaint();
+    }
+    
+    // records into "SimpleEQ Captures" in the user's documents. returns false if the directory couldn't be made
+    bool toggleCapture(bool enabled);
+    
+    // called on the message thread if a capture stops because a file couldn't be made
+    std::function<void()> onCaptureFailed;
+    
+    // gets a column from every analyzer frame while it's showing. nullptr to stop
+    void setSpectrogram(SpectrogramComponent* newSpectrogram)
+    {
+        spectrogram = newSpectrogram;
+    }
+    
+    // display frames that had nothing new to draw, so nothing was repainted
+    juce::uint64 getNumSkippedFrames() const { return numSkippedFrames; }
+    
+    // times paint() actually ran, whatever asked for it
+    juce::uint64 getNumPaints() const { return numPaints; }
+    
+    // a display refresh for a component that isn't on screen, so gets none of its own (see Tools/)
+    void refreshNow() { onVBlank(); }
+    
+    // the grid is back from the pool and, if the analyzer is shown, it has traces to draw.
+    // until then paint() draws black where they go
+    bool isFullyRendered() const;
+    
+private:
+    SimpleEQAudioProcessor& audioProcessor;
+    juce::Atomic<bool> parametersChanged { false };
+    
+    // what the processor is running, by the version it published it under
+    ChainSnapshot chainSnapshot;
+    uint32_t chainSnapshotVersion = 0;
+    
+    // frames since a parameter changed without the processor publishing a new design, -1 if none did.
+    // if the audio thread isn't running, the curve is designed here instead after a few frames
+    int ticksWaitingForProcessor = -1;
+    static constexpr int maxTicksWaitingForProcessor = 6;
+    
+    void designChainHere();
+    
+    // magnitudes (dB) per pixel and the curve through them, rebuilt only after a new chain snapshot or resized()
+    std::vector<float> mags, pixelFrequencies;
+    juce::Path responseCurve;
+    bool responseCurveIsValid = false;
+    
+    void updateResponseCurve();
+    
+    /*
+     paint() only composites three cached layers, each rendered at the display's pixel scale so
+     nothing is resampled: the grid and labels (new size or scale), the analyzer traces (new
+     analyzer data) and the response curve (new chain snapshot)
+     */
+    juce::Image gridLayer, analyzerLayer, curveLayer;
+    float layerScale = 0.f;
+    bool gridLayerIsValid = false, analyzerLayerIsValid = false, curveLayerIsValid = false;
+    
+    // sizes and clears layer for the component at layerScale, then lets draw paint it in component coordinates
+    template<typename DrawFunction>
+    void renderLayer(juce::Image& layer, juce::Image::PixelFormat format, DrawFunction&& draw)
+    {
+        auto width = juce::jmax(1, juce::roundToInt(getWidth() * layerScale));
+        auto height = juce::jmax(1, juce::roundToInt(getHeight() * layerScale));
+        
+        if ( ! layer.isValid() || layer.getWidth() != width || layer.getHeight() != height || layer.getFormat() != format )
+            layer = juce::Image(format, width, height, true);
+        else
+            layer.clear(layer.getBounds());
+        
+        juce::Graphics g(layer);
+        g.addTransform(juce::AffineTransform::scale((float) width / (float) juce::jmax(1, getWidth()),
+                                                    (float) height / (float) juce::jmax(1, getHeight())));
+        draw(g);
+    }
+    
+    /*
+     the grid is rendered on the analysis pool, so opening an editor doesn't wait for it. paint()
+     shows the previous grid (or black) until it's back. a render for an older size or scale is
+     dropped by its generation
+     */
+    int gridGeneration = 0;
+    bool gridLayerIsPending = false;
+    
+    void requestGridLayer();
+    
+    // only uses what it's given, so it can run on any thread
+    static void drawGrid(juce::Graphics& g, juce::Rectangle<int> bounds, juce::Rectangle<int> renderArea, juce::Rectangle<int> analysisArea);
+    void drawAnalyzerTraces(juce::Graphics& g);
+    
+    // area to draw background grid
+    juce::Rectangle<int> getRenderArea();
+    
+    juce::Rectangle<int> getAnalysisArea();
+    
+    juce::SharedResourcePointer<AnalysisThreadPool> analysisThreadPool;
+    
+    // what the analyzer should do, kept here so it can be set before the analyzer exists
+    struct AnalyzerSettings
+    {
+        bool midSide = false;
+        FFTOrder order = orderAuto;
+        AnalyzerWindow window = BlackmanHarris;
+        SpectrumSmoothing smoothing = NoSmoothing;
+        FrameMerge frameMerge = MergeLatest;
+        bool measuring = false;
+    };
+    
+    AnalyzerSettings analyzerSettings;
+    
+    // the FFTs, their buffers and the job that runs them: most of an editor's memory and start up time
+    struct Analyzer
+    {
+        Analyzer(SimpleEQAudioProcessor& p) :
+        pathProducer(p.leftChannelFifo, p.rightChannelFifo, p.inputChannelFifo, p.analyzerFifoReadLock)
+        {
+        }
+        
+        PathProducer pathProducer;
+        AnalyzerJob job { pathProducer };
+    };
+    
+    // nullptr until the analyzer is first shown (or a capture starts)
+    std::unique_ptr<Analyzer> analyzer;
+    
+    // makes the analyzer and attaches it to the processor's fifos if it doesn't exist yet
+    Analyzer& getAnalyzer();
+    void applyAnalyzerSettings();
+    
+    // whether we've asked the processor to feed its input fifo, see SimpleEQAudioProcessor::startMeasuring()
+    bool isMeasuringInput = false;
+    
+    // analyzer traces as last drawn, already in component coordinates
+    std::array<juce::Path, NumSpectra> analyzerPaths;
+    std::array<juce::Path, NumMeasurementTraces> measurementPaths;
+    
+    SpectrogramComponent* spectrogram = nullptr;
+    std::vector<uint8_t> spectrogramColumn;
+    
+    bool shouldShowFFTAnalysis = true;
+    
+    // once per display refresh: collects analyzer results, queues the next round, and repaints
+    // only what changed. nothing new means no repaint at all
+    void onVBlank();
+    
+    juce::uint64 numSkippedFrames = 0, numPaints = 0;
+    
+    // the analyzer is queued at most this often, however fast the display refreshes
+    static constexpr double minAnalyzerIntervalMs = 1000.0 / 60.0 - 1.0;
+    double lastAnalyzerQueuedMs = 0.0;
+    
+    // last, so it can't call onVBlank() before everything above exists
+    juce::VBlankAttachment vBlankAttachment { this, [this] { onVBlank(); } };
+};
+
+
+//==============================================================================
+//
+struct PowerButton : juce::ToggleButton { };
+struct AnalyzerButton : juce::ToggleButton
+{
+    // computes random path the toggle button will draw
+    void resized() override
+    {
+        auto bounds = getLocalBounds();
+        auto insetRect = bounds.reduced(4);
+        
+        randomPath.clear();
+        
+        juce::Random r;
+        
+        randomPath.startNewSubPath(insetRect.getX(),
+                                   insetRect.getY() + insetRect.getHeight() * r.nextFloat());
+        
+        for ( auto x = insetRect.getX() + 1; x < insetRect.getRight(); x += 2 )
+        {
+            randomPath.lineTo(x,
+                              insetRect.getY() + insetRect.getHeight() * r.nextFloat());
+        }
+        
+    }
+    
+    juce::Path randomPath;
+};
+/**
+*/
+class SimpleEQAudioProcessorEditor  : public juce::AudioProcessorEditor
+{
+public:
+    SimpleEQAudioProcessorEditor (SimpleEQAudioProcessor&);
+    ~SimpleEQAudioProcessorEditor() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    
+   #if SIMPLEEQ_PAINT_PROFILER
+    // P shows or hides the paint profile, D writes it to the user's documents
+    bool keyPressed(const juce::KeyPress& key) override;
+   #endif
+
+private:
+    // This reference is provided as a quick way for your editor to
+    // access the processor object that created it.
+    SimpleEQAudioProcessor& audioProcessor;
+    
+    //query an atomic flag to decide if the chain needs updating and if component needs to be repainted
+//    juce::Atomic<bool> parametersChanged { false };
+    
+    RotarySliderWithLabels peakFreqSlider,
+                        peakGainSlider,
+                        peakQualitySlider,
+                        lowCutFreqSlider,
+                        highCutFreqSlider,
+                        lowCutSlopeSlider,
+                        highCutSlopeSlider;
+    
+    SpectrogramComponent spectrogramComponent;
+    ResponseCurveComponent responseCurveComponent;
+    
+                        
+    using APVTS = juce::AudioProcessorValueTreeState;
+    using Attachment = APVTS::SliderAttachment;
+    
+    Attachment peakFreqSliderAttachement,
+                peakGainSliderAttachment,
+                peakQualitySliderAttachment,
+                lowCutFreqSliderAttachment,
+                highCutFreqSliderAttachment,
+                lowCutSlopeSliderAttachment,
+                highCutSlopeSliderAttachment;
+    
+    PowerButton lowCutBypassButton, peakBypassButton, highCutBypassButton;
+    AnalyzerButton analyzerEnabledButton;
+    
+    // analyzer display options, not automatable so they aren't parameters
+    juce::ToggleButton midSideButton { "M/S" }, spectrogramButton { "Spectrogram" }, measureButton { "Measure" }, captureButton { "Capture" };
+    
+    // extra editor height while the spectrogram is showing
+    static constexpr int spectrogramHeight = 80;
+    juce::ComboBox analyzerOrderComboBox, analyzerWindowComboBox, analyzerSmoothingComboBox, analyzerMergeComboBox;
+    
+    using ButtonAttachment = APVTS::ButtonAttachment;
+    ButtonAttachment    lowCutBypassButtonAttachment,
+                        peakBypassButtonAttachment,
+                        highCutBypassButtonAttachment,
+                        analyzerEnabledButtonAttachment;
+    
+    std::vector<juce::Component*> getComps();
+    
+    // shared with the sliders and any other open editor
+    juce::SharedResourcePointer<LookAndFeel> lnf;
+    
+   #if SIMPLEEQ_PAINT_PROFILER
+    PaintProfilerOverlay paintProfilerOverlay;
+   #endif
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessorEditor)
+};
@@ -1,364 +1,712 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-//==============================================================================
-SimpleEQAudioProcessor::SimpleEQAudioProcessor()
-#ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor (BusesProperties()
-                     #if ! JucePlugin_IsMidiEffect
-                      #if ! JucePlugin_IsSynth
-                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                      #endif
-                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-                     #endif
-                       )
-#endif
-{
-}
-
-SimpleEQAudioProcessor::~SimpleEQAudioProcessor()
-{
-}
-
-//==============================================================================
-const juce::String SimpleEQAudioProcessor::getName() const
-{
-    return JucePlugin_Name;
-}
-
-bool SimpleEQAudioProcessor::acceptsMidi() const
-{
-   #if JucePlugin_WantsMidiInput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool SimpleEQAudioProcessor::producesMidi() const
-{
-   #if JucePlugin_ProducesMidiOutput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool SimpleEQAudioProcessor::isMidiEffect() const
-{
-   #if JucePlugin_IsMidiEffect
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-double SimpleEQAudioProcessor::getTailLengthSeconds() const
-{
-    return 0.0;
-}
-
-int SimpleEQAudioProcessor::getNumPrograms()
-{
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
-}
-
-int SimpleEQAudioProcessor::getCurrentProgram()
-{
-    return 0;
-}
-
-void SimpleEQAudioProcessor::setCurrentProgram (int index)
-{
-}
-
-const juce::String SimpleEQAudioProcessor::getProgramName (int index)
-{
-    return {};
-}
-
-void SimpleEQAudioProcessor::changeProgramName (int index, const juce::String& newName)
-{
-}
-
-//==============================================================================
-void SimpleEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
-    
-    juce::dsp::ProcessSpec spec;
-    
-    spec.maximumBlockSize = samplesPerBlock;
-    
-    spec.numChannels = 1;
-    
-    spec.sampleRate = sampleRate;
-    
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
-
-    updateFilters();
-    
-    // prepare Fifo
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
-    
-    // initiallize test oscillator
-    osc.initialise([](float x) { return std::sin(x); });
-    
-    spec.numChannels = getTotalNumInputChannels();
-    osc.prepare(spec);
-    osc.setFrequency(100);
-                   
-}
-
-void SimpleEQAudioProcessor::releaseResources()
-{
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
-}
-
-#ifndef JucePlugin_PreferredChannelConfigurations
-bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
-{
-  #if JucePlugin_IsMidiEffect
-    juce::ignoreUnused (layouts);
-    return true;
-  #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
-
-    // This checks if the input layout matches the output layout
-   #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-   #endif
-
-    return true;
-  #endif
-}
-#endif
-
-void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
-{
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-
-    // In case we have more outputs than inputs, this code clears any output
-    // channels that didn't contain input data, (because these aren't
-    // guaranteed to be empty - they may contain garbage).
-    // This is here to avoid people getting screaming feedback
-    // when they first compile a plugin, but obviously you don't need to keep
-    // this code if your algorithm always overwrites all the output channels.
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-    
-    updateFilters();
-    
-    juce::dsp::AudioBlock<float> block(buffer);
-
-    // oscillator test
-//    buffer.clear();
-//
-//    juce::dsp::ProcessContextReplacing<float> stereoContext(block);
-//    osc.process(stereoContext);
-
-    //gets outputs
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
-    
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
-    
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
-    
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
-
-}
-
-//==============================================================================
-bool SimpleEQAudioProcessor::hasEditor() const
-{
-    return true; // (change this to false if you choose to not supply an editor)
-}
-
-juce::AudioProcessorEditor* SimpleEQAudioProcessor::createEditor()
-{
-    return new SimpleEQAudioProcessorEditor (*this);
-//  return new juce::GenericAudioProcessorEditor(*this);
-}
-
-//==============================================================================
-void SimpleEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
-{
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-    
-    juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
-}
-
-void SimpleEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
-{
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
-        
-    auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
-
-    if (tree.isValid())
-    {
-        apvts.replaceState(tree);
-        updateFilters();
-    }
-}
-
-// sets member variables for Chain Settings
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
-{
-    ChainSettings settings;
-    
-    settings.lowCutFreq = apvts.getRawParameterValue("LowCut Freq")->load();
-    settings.highCutFreq = apvts.getRawParameterValue("HighCut Freq")->load();
-    settings.peakFreq = apvts.getRawParameterValue("Peak Freq")->load();
-    settings.peakGainInDeccibels = apvts.getRawParameterValue("Peak Gain")->load();
-    settings.peakQuality = apvts.getRawParameterValue("Peak Quality")->load();
-    settings.lowCutSlope = static_cast<Slope>(apvts.getRawParameterValue("LowCut Slope")->load());
-    settings.highCutSlope = static_cast<Slope>(apvts.getRawParameterValue("HighCut Slope")->load());
-    
-    settings.lowCutBypassed =  apvts.getRawParameterValue("LowCut Bypassed")->load() > 0.5f;
-    settings.peakBypassed =  apvts.getRawParameterValue("Peak Bypassed")->load() > 0.5f;
-    settings.highCutBypassed =  apvts.getRawParameterValue("HighCut Bypassed")->load() > 0.5f;
-    
-    return settings;
-}
-
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate)
-{
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
-                                                               chainSettings.peakFreq,
-                                                               chainSettings.peakQuality,
-                                                               juce::Decibels::decibelsToGain(chainSettings.peakGainInDeccibels));
-}
-
-
-void SimpleEQAudioProcessor::updatePeakFilter(const ChainSettings &chainSettings)
-{
-    auto peakCoefficients = makePeakFilter(chainSettings, getSampleRate());
-    
-    leftChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
-    rightChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
-
-    updateCoefficients(leftChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
-}
-
-void updateCoefficients(Coefficients &old, const Coefficients &replacements)
-{
-    *old = *replacements;
-}
-
-void SimpleEQAudioProcessor::updateLowCutFilters(const ChainSettings &chainSettings)
-{
-    auto cutCoefficients = makeLowCutFilter(chainSettings, getSampleRate());
-    auto& leftLowCut = leftChain.get<ChainPositions::LowCut>();
-    auto& rightLowCut = rightChain.get<ChainPositions::LowCut>();
-    
-    leftChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
-    rightChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
-    
-    updateCutFilter(leftLowCut, cutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(rightLowCut, cutCoefficients, chainSettings.lowCutSlope);
-}
-
-//update high cut filter values
-void SimpleEQAudioProcessor::updateHighCutFilters(const ChainSettings &chainSettings)
-{
-//    This method returns an array of IIR::Coefficients, made to be used in
-//        cascaded IIRFilters, providing a minimum phase high-pass filter without any
-//        ripple in the pass band and in the stop band.
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, getSampleRate());
-    auto& leftHighCut = leftChain.get<ChainPositions::HighCut>();
-    auto& rightHighCut = rightChain.get<ChainPositions::HighCut>();
-    
-    leftChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
-    rightChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
-    
-    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.highCutSlope);
-    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.highCutSlope);
-}
-
-// one function to rule all filter updates
-void SimpleEQAudioProcessor::updateFilters()
-{
-    auto chainSettings = getChainSettings(apvts);
-    
-    updateLowCutFilters(chainSettings);
-    updatePeakFilter(chainSettings);
-    updateHighCutFilters(chainSettings);
-}
-
-// creates Layout for each slider, along with range, skew, and starting point
-juce::AudioProcessorValueTreeState::ParameterLayout
-    SimpleEQAudioProcessor::createParameterLayout()
-{
-        juce::AudioProcessorValueTreeState::ParameterLayout layout;
-        //Low Cut Frequency, range 20hz-20khz, skew at .33f, starts at 20hz
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "LowCut Freq", 1 }, "LowCut Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.33f), 20.f));
-        //high Cut Frequency, range 20hz-20khz, skew at .33f, starts at 20khz
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "HighCut Freq", 1 }, "HighCut Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.33f), 20000.f));
-        //peak frequency, range 20hz-20khz, skew at .33, start at 750hz
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "Peak Freq", 1 }, "Peak Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.33f), 750.f));
-        //gain for peak frequency, from -24db to 24db, skew by .5, start at 0db
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "Peak Gain", 1 }, "Peak Gain", juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f), 0.0f));
-        // Q factor for peak frequency, range .1 to 10, starts at 1
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "Peak Quality", 1 }, "Peak Quality", juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f), 1.0f));
-        
-        //array to set cut filter db range
-        juce::StringArray stringArray;
-        //gets values 12, 24, 36, 48
-        for (int i = 0; i < 4; ++i)
-        {
-            juce::String str;
-            str << (12 + i * 12);
-            str << " db/Oct";
-            stringArray.add(str);
-        }
-        
-        //high cut and low cut slope with values set by string Array
-        layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { "LowCut Slope", 1 }, "LowCut Slope", stringArray, 0));
-                                   
-        layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { "HighCut Slope", 1 }, "HighCut Slope", stringArray, 0));
-        
-        // bypass booleans
-        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "LowCut Bypassed" , 1 }, "LowCut Bypassed",                                                                           false));
-        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "Peak Bypassed", 1 } ,"Peak Bypassed",                                                                                false));
-        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "HighCut Bypassed", 1}, "HighCut Bypassed",                                                                           false));
-        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "Analyzer Enabled", 1 }, "Analyzer Enabled",                                                                          true));
-        
-        return layout;
-}
-//==============================================================================
-// This creates new instances of the plugin..
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
-{
-    return new SimpleEQAudioProcessor();
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+SimpleEQAudioProcessor::SimpleEQAudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor (BusesProperties()
+                     #if ! JucePlugin_IsMidiEffect
+                      #if ! JucePlugin_IsSynth
+                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                      #endif
+                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                     #endif
+                       )
+#endif
+{
+    // looked up by ID once here, never again
+    for (const auto& spec : parameterSpecs)
+    {
+        parameterValues[(size_t) spec.index] = apvts.getRawParameterValue(spec.id);
+        parameters[(size_t) spec.index] = apvts.getParameter(spec.id);
+        jassert(parameterValues[(size_t) spec.index] != nullptr && parameters[(size_t) spec.index] != nullptr);
+    }
+}
+
+SimpleEQAudioProcessor::~SimpleEQAudioProcessor()
+{
+}
+
+//==============================================================================
+const juce::String SimpleEQAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool SimpleEQAudioProcessor::acceptsMidi() const
+{
+   #if JucePlugin_WantsMidiInput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SimpleEQAudioProcessor::producesMidi() const
+{
+   #if JucePlugin_ProducesMidiOutput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SimpleEQAudioProcessor::isMidiEffect() const
+{
+   #if JucePlugin_IsMidiEffect
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+double SimpleEQAudioProcessor::getTailLengthSeconds() const
+{
+    return 0.0;
+}
+
+int SimpleEQAudioProcessor::getNumPrograms()
+{
+    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                // so this should be at least 1, even if you're not really implementing programs.
+}
+
+int SimpleEQAudioProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void SimpleEQAudioProcessor::setCurrentProgram (int index)
+{
+}
+
+const juce::String SimpleEQAudioProcessor::getProgramName (int index)
+{
+    return {};
+}
+
+void SimpleEQAudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+}
+
+//==============================================================================
+void SimpleEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    // Use this method as the place to do any pre-playback
+    // initialisation that you need..
+    
+    juce::dsp::ProcessSpec spec;
+    
+    spec.maximumBlockSize = samplesPerBlock;
+    
+    spec.numChannels = 1;
+    
+    spec.sampleRate = sampleRate;
+    
+    leftChain.prepare(spec);
+    rightChain.prepare(spec);
+
+    // prepare() only clears the filters' state, the coefficients stay. hosts prepare again on
+    // every transport start or reactivation, so nothing is designed unless the rate or a parameter changed
+    updateBlockParameters();
+    updateFilters();
+    
+    // prepare Fifo, but only if someone is looking at it, and only if the block size changed
+    if (samplesPerBlock != analyzerBlockSize)
+    {
+        const juce::ScopedLock readLock(analyzerFifoReadLock);
+        const juce::SpinLock::ScopedLockType lock(analyzerLock);
+        analyzerBlockSize = samplesPerBlock;
+        prepareAnalyzerFifos();
+    }
+    
+    // test signal generator, fades in from silence when it's switched on
+    signalGenerator.prepare(sampleRate);
+    generatorGain = 0.f;
+}
+
+void SimpleEQAudioProcessor::releaseResources()
+{
+    // When playback stops, you can use this as an opportunity to free up any
+    // spare memory, etc.
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+  #if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+  #else
+    // This is the place where you check if the layout is supported.
+    // In this template code we only support mono or stereo.
+    // Some plugin hosts, such as certain GarageBand versions, will only
+    // load plugins that support stereo bus layouts.
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+    // This checks if the input layout matches the output layout
+   #if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+   #endif
+
+    return true;
+  #endif
+}
+#endif
+
+void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    // In case we have more outputs than inputs, this code clears any output
+    // channels that didn't contain input data, (because these aren't
+    // guaranteed to be empty - they may contain garbage).
+    // This is here to avoid people getting screaming feedback
+    // when they first compile a plugin, but obviously you don't need to keep
+    // this code if your algorithm always overwrites all the output channels.
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+    
+    updateBlockParameters();
+    updateFilters();
+    
+    // the test signal goes through the EQ (and into the measurement) like any other input
+    renderSignalGenerator(buffer);
+    
+    // the EQ works in place, so a measurement needs the input copied before it runs
+    const auto numSamples = buffer.getNumSamples();
+    const bool inputCopied = measuringActive.load() && buffer.getNumChannels() > Channel::Left;
+    
+    if (inputCopied)
+    {
+        analyzerInputBuffer.setSize(2, numSamples, false, false, true);
+        analyzerInputBuffer.copyFrom(Channel::Left, 0, buffer, Channel::Left, 0, numSamples);
+    }
+    
+    juce::dsp::AudioBlock<float> block(buffer);
+
+    //gets outputs
+    auto leftBlock = block.getSingleChannelBlock(0);
+    auto rightBlock = block.getSingleChannelBlock(1);
+    
+    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
+    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
+    
+    leftChain.process(leftContext);
+    rightChain.process(rightContext);
+    
+    /*
+     never wait on the message thread here, just skip the analyzer for this block.
+     all the fifos are updated under one lock, so the input and output fifos always see the same blocks
+     */
+    const juce::SpinLock::ScopedTryLockType lock(analyzerLock);
+    
+    // measuring may have started since the input was checked. without a copy the whole block is skipped, so the output never gets ahead of the input
+    const bool measuring = measuringActive.load();
+    
+    if (lock.isLocked() && analyzerActive && (inputCopied || ! measuring))
+    {
+        if (measuring)
+            inputChannelFifo.update(analyzerInputBuffer);
+        
+        leftChannelFifo.update(buffer);
+        rightChannelFifo.update(buffer);
+    }
+
+}
+
+// generated once into the first channel and copied to the others
+void SimpleEQAudioProcessor::renderSignalGenerator(juce::AudioBuffer<float>& buffer)
+{
+    auto type = static_cast<SignalType>((int) blockParameters[GeneratorTypeParameter]);
+    signalGenerator.setType(type);
+    
+    if (type == SignalOff)
+    {
+        generatorGain = 0.f;
+        return;
+    }
+    
+    signalGenerator.setFrequency(blockParameters[GeneratorFreqParameter]);
+    auto gain = juce::Decibels::decibelsToGain(blockParameters[GeneratorLevelParameter]);
+    
+    auto numSamples = buffer.getNumSamples();
+    signalGenerator.process(buffer.getWritePointer(0), numSamples);
+    
+    // ramps from the last block's level so level changes don't zipper
+    buffer.applyGainRamp(0, 0, numSamples, generatorGain, gain);
+    generatorGain = gain;
+    
+    for (int channel = 1; channel < buffer.getNumChannels(); ++channel)
+        buffer.copyFrom(channel, 0, buffer, 0, 0, numSamples);
+}
+
+//==============================================================================
+void SimpleEQAudioProcessor::attachAnalyzer()
+{
+    const juce::ScopedLock readLock(analyzerFifoReadLock);
+    const juce::SpinLock::ScopedLockType lock(analyzerLock);
+    
+    if (++numAttachedAnalyzers == 1)
+        prepareAnalyzerFifos();
+}
+
+void SimpleEQAudioProcessor::detachAnalyzer()
+{
+    const juce::ScopedLock readLock(analyzerFifoReadLock);
+    const juce::SpinLock::ScopedLockType lock(analyzerLock);
+    
+    jassert(numAttachedAnalyzers > 0);
+    
+    if (--numAttachedAnalyzers == 0)
+    {
+        jassert(numMeasuringAnalyzers == 0);
+        
+        analyzerActive = false;
+        measuringActive = false;
+        leftChannelFifo.release();
+        rightChannelFifo.release();
+        inputChannelFifo.release();
+    }
+}
+
+void SimpleEQAudioProcessor::startMeasuring()
+{
+    const juce::ScopedLock readLock(analyzerFifoReadLock);
+    const juce::SpinLock::ScopedLockType lock(analyzerLock);
+    
+    jassert(numAttachedAnalyzers > 0);
+    
+    // all three start again empty (Fifo::prepare resets them), so the input lines up with the output
+    if (++numMeasuringAnalyzers == 1)
+        prepareAnalyzerFifos();
+}
+
+void SimpleEQAudioProcessor::stopMeasuring()
+{
+    const juce::ScopedLock readLock(analyzerFifoReadLock);
+    const juce::SpinLock::ScopedLockType lock(analyzerLock);
+    
+    jassert(numMeasuringAnalyzers > 0);
+    
+    if (--numMeasuringAnalyzers == 0)
+    {
+        measuringActive = false;
+        inputChannelFifo.release();
+    }
+}
+
+// must be called with analyzerFifoReadLock and analyzerLock held
+void SimpleEQAudioProcessor::prepareAnalyzerFifos()
+{
+    analyzerActive = false;
+    measuringActive = false;
+    
+    if (numAttachedAnalyzers == 0 || analyzerBlockSize <= 0)
+        return;
+    
+    leftChannelFifo.prepare(analyzerBlockSize);
+    rightChannelFifo.prepare(analyzerBlockSize);
+    analyzerActive = true;
+    
+    if (numMeasuringAnalyzers > 0)
+    {
+        /*
+         room for the input copy the measurement takes, see processBlock(). only instances that
+         measure pay for it. the audio thread doesn't copy until measuringActive is set below,
+         and once sized it's only resized for a new block size
+         */
+        analyzerInputBuffer.setSize(2, analyzerBlockSize, false, false, true);
+        inputChannelFifo.prepare(analyzerBlockSize);
+        measuringActive = true;
+    }
+}
+
+//==============================================================================
+bool SimpleEQAudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* SimpleEQAudioProcessor::createEditor()
+{
+    return new SimpleEQAudioProcessorEditor (*this);
+//  return new juce::GenericAudioProcessorEditor(*this);
+}
+
+//==============================================================================
+void SimpleEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    // You should use this method to store your parameters in the memory block.
+    // You could do that either as raw data, or use the XML or ValueTree classes
+    // as intermediaries to make it easy to save and load complex data.
+    
+    // straight from the parameters into StateFormat.h's layout, no ValueTree in between
+    auto values = loadParameters(parameterValues);
+    
+    destData.setSize(StateFormat::getStateSize(NumParameters));
+    StateFormat::writeState(destData.getData(), values.data(), NumParameters);
+}
+
+namespace
+{
+    // states saved before StateFormat.h: the apvts ValueTree, with a PARAM child per parameter
+    bool readValueTreeState(const void* data, int sizeInBytes, ParameterSnapshot& values)
+    {
+        auto tree = juce::ValueTree::readFromData(data, (size_t) sizeInBytes);
+        
+        if (!tree.isValid())
+            return false;
+        
+        for (const auto& spec : parameterSpecs)
+        {
+            auto child = tree.getChildWithProperty("id", spec.id);
+            
+            if (child.isValid() && child.hasProperty("value"))
+                values[(size_t) spec.index] = (float) child.getProperty("value");
+        }
+        
+        return true;
+    }
+}
+
+void SimpleEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    // You should use this method to restore your parameters from this memory block,
+    // whose contents will have been created by the getStateInformation() call.
+    
+    if (sizeInBytes <= 0)
+        return;
+    
+    // anything a state doesn't have stays at its default, like it would in a new instance
+    auto values = getDefaultParameters();
+    
+    if (StateFormat::readState(data, (size_t) sizeInBytes, values.data(), NumParameters)
+        || readValueTreeState(data, sizeInBytes, values))
+    {
+        applyState(values);
+    }
+}
+
+void SimpleEQAudioProcessor::applyState(ParameterSnapshot state)
+{
+    // what the parameters will hold once they're set, so blocks in between design for the same thing
+    for (const auto& spec : parameterSpecs)
+    {
+        auto& value = state[(size_t) spec.index];
+        value = juce::jlimit(spec.minimum, spec.maximum, value);
+        
+        if (spec.type != FloatParameter)
+            value = std::round(value);
+    }
+    
+    {
+        const juce::SpinLock::ScopedLockType lock(stateLock);
+        incomingState = state;
+        stateIsBeingApplied = true;
+    }
+    
+    for (const auto& spec : parameterSpecs)
+    {
+        auto* parameter = parameters[(size_t) spec.index];
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(state[(size_t) spec.index]));
+    }
+    
+    const juce::SpinLock::ScopedLockType lock(stateLock);
+    stateIsBeingApplied = false;
+}
+
+void SimpleEQAudioProcessor::updateBlockParameters()
+{
+    const juce::SpinLock::ScopedTryLockType lock(stateLock);
+    
+    // a state is being swapped in right now: this block runs on the last one's values
+    if (!lock.isLocked())
+        return;
+    
+    blockParameters = stateIsBeingApplied ? incomingState : loadParameters(parameterValues);
+}
+
+ParameterSnapshot loadParameters(const ParameterValues& values)
+{
+    ParameterSnapshot snapshot;
+    
+    for (size_t i = 0; i < snapshot.size(); ++i)
+        snapshot[i] = loadParameter(values, static_cast<ParameterIndex>(i));
+    
+    return snapshot;
+}
+
+// sets member variables for Chain Settings
+ChainSettings getChainSettings(const ParameterSnapshot& parameters)
+{
+    ChainSettings settings;
+    
+    settings.lowCutFreq = parameters[LowCutFreqParameter];
+    settings.highCutFreq = parameters[HighCutFreqParameter];
+    settings.peakFreq = parameters[PeakFreqParameter];
+    settings.peakGainInDeccibels = parameters[PeakGainParameter];
+    settings.peakQuality = parameters[PeakQualityParameter];
+    settings.lowCutSlope = static_cast<Slope>(parameters[LowCutSlopeParameter]);
+    settings.highCutSlope = static_cast<Slope>(parameters[HighCutSlopeParameter]);
+    
+    settings.lowCutBypassed = parameters[LowCutBypassedParameter] > 0.5f;
+    settings.peakBypassed = parameters[PeakBypassedParameter] > 0.5f;
+    settings.highCutBypassed = parameters[HighCutBypassedParameter] > 0.5f;
+    
+    return settings;
+}
+
+ChainSettings getChainSettings(const ParameterValues& values)
+{
+    return getChainSettings(loadParameters(values));
+}
+
+ChainSnapshot makeChainSnapshot(const MonoChain& chain, double sampleRate)
+{
+    ChainSnapshot snapshot;
+    snapshot.sampleRate = sampleRate;
+    
+    // IIR::Coefficients keeps b0, b1, (b2,) a1, (a2) already divided by a0
+    auto addFilter = [&snapshot](const Filter& filter)
+    {
+        if (filter.coefficients == nullptr)
+            return;
+        
+        const auto& c = filter.coefficients->coefficients;
+        
+        if (c.size() == 5)
+            snapshot.add({ c[0], c[1], c[2], c[3], c[4] });
+        else if (c.size() == 3)
+            snapshot.add({ c[0], c[1], 0.0, c[2], 0.0 });
+    };
+    
+    auto addCutFilter = [&addFilter](const CutFilter& cut)
+    {
+        if (!cut.isBypassed<0>())
+            addFilter(cut.get<0>());
+        if (!cut.isBypassed<1>())
+            addFilter(cut.get<1>());
+        if (!cut.isBypassed<2>())
+            addFilter(cut.get<2>());
+        if (!cut.isBypassed<3>())
+            addFilter(cut.get<3>());
+    };
+    
+    if (!chain.isBypassed<ChainPositions::LowCut>())
+        addCutFilter(chain.get<ChainPositions::LowCut>());
+    
+    if (!chain.isBypassed<ChainPositions::Peak>())
+        addFilter(chain.get<ChainPositions::Peak>());
+    
+    if (!chain.isBypassed<ChainPositions::HighCut>())
+        addCutFilter(chain.get<ChainPositions::HighCut>());
+    
+    return snapshot;
+}
+
+ChainSnapshot designChainSnapshot(const ChainSettings& chainSettings, double sampleRate)
+{
+    MonoChain chain;
+    
+    chain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
+    chain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
+    chain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
+    
+    updateCoefficients(chain.get<ChainPositions::Peak>().coefficients, makePeakFilter(chainSettings, sampleRate));
+    updateCutFilter(chain.get<ChainPositions::LowCut>(), makeLowCutFilter(chainSettings, sampleRate), chainSettings.lowCutSlope);
+    updateCutFilter(chain.get<ChainPositions::HighCut>(), makeHighCutFilter(chainSettings, sampleRate), chainSettings.highCutSlope);
+    
+    return makeChainSnapshot(chain, sampleRate);
+}
+
+Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
+                                                               chainSettings.peakFreq,
+                                                               chainSettings.peakQuality,
+                                                               juce::Decibels::decibelsToGain(chainSettings.peakGainInDeccibels));
+}
+
+
+void SimpleEQAudioProcessor::updatePeakFilter(const ChainSettings &chainSettings)
+{
+    auto peakCoefficients = makePeakFilter(chainSettings, getSampleRate());
+    
+    leftChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
+    rightChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
+
+    updateCoefficients(leftChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+    updateCoefficients(rightChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+}
+
+void updateCoefficients(Coefficients &old, const Coefficients &replacements)
+{
+    *old = *replacements;
+}
+
+void SimpleEQAudioProcessor::updateLowCutFilters(const ChainSettings &chainSettings)
+{
+    auto cutCoefficients = makeLowCutFilter(chainSettings, getSampleRate());
+    auto& leftLowCut = leftChain.get<ChainPositions::LowCut>();
+    auto& rightLowCut = rightChain.get<ChainPositions::LowCut>();
+    
+    leftChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
+    rightChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
+    
+    updateCutFilter(leftLowCut, cutCoefficients, chainSettings.lowCutSlope);
+    updateCutFilter(rightLowCut, cutCoefficients, chainSettings.lowCutSlope);
+}
+
+//update high cut filter values
+void SimpleEQAudioProcessor::updateHighCutFilters(const ChainSettings &chainSettings)
+{
+//    This method returns an array of IIR::Coefficients, made to be used in
+//        cascaded IIRFilters, providing a minimum phase high-pass filter without any
+//        ripple in the pass band and in the stop band.
+    auto highCutCoefficients = makeHighCutFilter(chainSettings, getSampleRate());
+    auto& leftHighCut = leftChain.get<ChainPositions::HighCut>();
+    auto& rightHighCut = rightChain.get<ChainPositions::HighCut>();
+    
+    leftChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
+    rightChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
+    
+    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.highCutSlope);
+    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.highCutSlope);
+}
+
+// one function to rule all filter updates
+void SimpleEQAudioProcessor::updateFilters()
+{
+    auto chainSettings = getChainSettings(blockParameters);
+    auto sampleRate = getSampleRate();
+    
+    if (filtersDesigned && chainSettings == designedSettings && sampleRate == designedSampleRate)
+    {
+        // last design didn't get out yet
+        if (chainSnapshotPending)
+            publishChainSnapshot();
+        
+        return;
+    }
+    
+    updateLowCutFilters(chainSettings);
+    updatePeakFilter(chainSettings);
+    updateHighCutFilters(chainSettings);
+    
+    designedSettings = chainSettings;
+    designedSampleRate = sampleRate;
+    filtersDesigned = true;
+    
+    // both channels run the same coefficients
+    pendingChainSnapshot = makeChainSnapshot(leftChain, sampleRate);
+    chainSnapshotPending = true;
+    publishChainSnapshot();
+}
+
+void SimpleEQAudioProcessor::publishChainSnapshot()
+{
+    const juce::SpinLock::ScopedTryLockType lock(chainSnapshotLock);
+    
+    if (!lock.isLocked())
+        return;
+    
+    publishedChainSnapshot = pendingChainSnapshot;
+    chainSnapshotVersion.store(chainSnapshotVersion.load() + 1);
+    chainSnapshotPending = false;
+}
+
+bool SimpleEQAudioProcessor::getChainSnapshot(ChainSnapshot& snapshot, uint32_t& version)
+{
+    // the version only moves under the lock, so it's safe to peek at without it
+    if (chainSnapshotVersion.load() == version)
+        return false;
+    
+    const juce::SpinLock::ScopedLockType lock(chainSnapshotLock);
+    snapshot = publishedChainSnapshot;
+    version = chainSnapshotVersion.load();
+    return true;
+}
+
+namespace
+{
+    /*
+     the choice lists never change, so they're built on the first call and kept for the
+     process. every AudioParameterChoice copies its list, and a copied juce::String shares
+     its text (the reference count is atomic), so later instances allocate no strings for them
+     */
+    const juce::StringArray& getChoiceList(ParameterChoices choices)
+    {
+        static const juce::StringArray slopeChoices = []
+        {
+            juce::StringArray list;
+            //gets values 12, 24, 36, 48
+            for (int i = 0; i < 4; ++i)
+            {
+                juce::String str;
+                str << (12 + i * 12);
+                str << " db/Oct";
+                list.add(str);
+            }
+            return list;
+        }();
+        
+        // in SignalType order
+        static const juce::StringArray generatorChoices { "Off", "Sine", "Sweep", "White Noise", "Pink Noise", "Impulse" };
+        
+        jassert(choices != NoChoices);
+        return choices == GeneratorChoices ? generatorChoices : slopeChoices;
+    }
+}
+
+// one parameter per entry in parameterSpecs, in the same order
+juce::AudioProcessorValueTreeState::ParameterLayout
+    SimpleEQAudioProcessor::createParameterLayout()
+{
+        juce::AudioProcessorValueTreeState::ParameterLayout layout;
+        
+        for (const auto& spec : parameterSpecs)
+        {
+            juce::ParameterID id { spec.id, 1 };
+            
+            switch (spec.type)
+            {
+                case FloatParameter:
+                    layout.add(std::make_unique<juce::AudioParameterFloat>(id, spec.id, juce::NormalisableRange<float>(spec.minimum, spec.maximum, spec.interval, spec.skew), spec.defaultValue));
+                    break;
+                    
+                case ChoiceParameter:
+                {
+                    const auto& choices = getChoiceList(spec.choices);
+                    jassert(choices.size() == (int) spec.maximum + 1);
+                    layout.add(std::make_unique<juce::AudioParameterChoice>(id, spec.id, choices, (int) spec.defaultValue));
+                    break;
+                }
+                    
+                case BoolParameter:
+                    layout.add(std::make_unique<juce::AudioParameterBool>(id, spec.id, spec.defaultValue > 0.5f));
+                    break;
+            }
+        }
+        
+        return layout;
+}
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new SimpleEQAudioProcessor();
+}
@@ -1,314 +1,575 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-// fifo that gui thread can use to retrieve blocks that single channel fifo has produced
-#include <array>
-template<typename T>
-struct Fifo
-{
-    void prepare(int numChannels, int numSamples)
-    {
-        static_assert( std::is_same_v<T, juce::AudioBuffer<float>>,
-                      "prepare(numChannels, numSamples) should only be used when the Fifo is holding juce::AudioBuffer<float>");
-        
-        for( auto& buffer : buffers)
-        {
-            buffer.setSize(numChannels,
-                           numSamples,
-                           false,           //clear everything?
-                           true,            //including the extra space?
-                           true);           //avoid reallocating if you can?
-            buffer.clear();
-        }
-    }
-    
-    void prepare(size_t numElements)
-    {
-        static_assert( std::is_same_v<T, std::vector<float>>,
-                      "prepare(numElements) should only be used when the Fifo is holding juce::vector<float>");
-        for(auto& buffer : buffers )
-        {
-            buffer.clear();
-            buffer.resize(numElements, 0);
-        }
-        
-    }
-    
-    bool push(const T& t)
-    {
-        auto write = fifo.write(1);
-        if( write.blockSize1 > 0 )
-        {
-            buffers[write.startIndex1] = t;
-            return true;
-        }
-        
-        return false;
-    }
-    
-    bool pull(T& t)
-    {
-        auto read = fifo.read(1);
-        if( read.blockSize1 > 0 )
-        {
-            t = buffers[read.startIndex1];
-            return true;
-        }
-        
-        return false;
-    }
-    
-    int getNumAvailableForReading() const
-    {
-        return fifo.getNumReady();
-    }
-private:
-    static constexpr int Capacity = 30;
-    std::array<T, Capacity> buffers;
-    juce::AbstractFifo fifo {Capacity};
-};
-
-enum Channel
-{
-    Right, // effectively 0
-    Left //effectively 1
-};
-
-
-// collect samples into blocks of fixed sizes
-template<typename BlockType>
-struct SingleChannelSampleFifo
-{
-    SingleChannelSampleFifo(Channel ch) : channelToUse(ch)
-    {
-        prepared.set(false);
-    }
-    
-    void update(const BlockType& buffer)
-    {
-        jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse);
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
-        
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            pushNextSampleIntoFifo(channelPtr[i]);
-        }
-    }
-    
-    void prepare(int bufferSize)
-    {
-        prepared.set(false);
-        size.set(bufferSize);
-        
-        bufferToFill.setSize(1,             //channel
-                             bufferSize,    //num smaples
-                             false,         //keepExistingContent
-                             true,          //clear extra space
-                             true);         //avoid reallocating
-        audioBufferFifo.prepare(1, bufferSize);
-        fifoIndex = 0;
-        prepared.set(true);
-    }
-    //================================================================
-    int getNumCompleteBuffersAvailable() const { return audioBufferFifo.getNumAvailableForReading(); }
-    bool isPrepared() const { return prepared.get(); }
-    int getSize() const { return size.get(); }
-    //================================================================
-    bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
-private:
-    Channel channelToUse;
-    int fifoIndex = 0;
-    Fifo<BlockType> audioBufferFifo;
-    BlockType bufferToFill;
-    juce::Atomic<bool> prepared = false;
-    juce::Atomic<int> size = 0;
-    
-    void pushNextSampleIntoFifo(float sample)
-    {
-        if (fifoIndex == bufferToFill.getNumSamples())
-        {
-            auto ok = audioBufferFifo.push(bufferToFill);
-            
-            juce::ignoreUnused(ok);
-            
-            fifoIndex = 0;
-        }
-        
-        bufferToFill.setSample(0, fifoIndex, sample);
-        ++fifoIndex;
-    }
-};
-
-
-enum Slope
-{
-    Slope_12,
-    Slope_24,
-    Slope_36,
-    Slope_48
-};
-
-struct ChainSettings
-{
-    float peakFreq { 0 }, peakGainInDeccibels { 0 }, peakQuality { 1.f };
-    float lowCutFreq { 0 }, highCutFreq { 0 };
-    Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
-    
-    bool lowCutBypassed { false }, peakBypassed { false }, highCutBypassed { false };
-};
-
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState & apvts);
-
-using Filter = juce::dsp::IIR::Filter<float>;
-
-using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
-
-using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
-
-enum ChainPositions
-{
-    LowCut,
-    Peak,
-    HighCut
-};
-
-using Coefficients = Filter::CoefficientsPtr;
-void updateCoefficients(Coefficients& old, const Coefficients& replacements);
-
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate);
-
-template<int Index, typename ChainType, typename CoefficientType>
-void update(ChainType& chain, const CoefficientType& coefficients)
-{
-    updateCoefficients(chain.template get<Index>().coefficients, coefficients[Index]);
-    chain.template setBypassed<Index>(false);
-}
-
-//switches coefficient based on filter slope choice
-template<typename ChainType, typename CoefficientType>
-void updateCutFilter(ChainType& leftLowCut,
-                    const CoefficientType& cutCoefficients,
-                    //const ChainSettings& chainSettings)
-                    const Slope& lowCutSlope)
-{
-    leftLowCut.template setBypassed<0>(true);
-    leftLowCut.template setBypassed<1>(true);
-    leftLowCut.template setBypassed<2>(true);
-    leftLowCut.template setBypassed<3>(true);
-    
-    switch (lowCutSlope)
-    {
-        case Slope_48:
-        {
-            update<3>(leftLowCut, cutCoefficients);
-            //*leftLowCut.template get<3>().coefficients = *cutCoefficients[3];
-            //leftLowCut.template setBypassed<3>(false);
-        }
-        case Slope_36:
-        {
-            update<2>(leftLowCut, cutCoefficients);
-        }
-        case Slope_24:
-        {
-            update<1>(leftLowCut, cutCoefficients);
-        }
-        case Slope_12:
-        {
-            update<0>(leftLowCut, cutCoefficients);
-        }
-    }
-}
-
-inline auto makeLowCutFilter(const ChainSettings& chainSettings, double sampleRate)
-{
-    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq,
-                                                                                       sampleRate,
-                                                                                       2 * (chainSettings.lowCutSlope + 1));
-}
-
-inline auto makeHighCutFilter(const ChainSettings& chainSettings, double sampleRate)
-{
-    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq,
-                                                                                      sampleRate,
-                                                                                      2 * (chainSettings.highCutSlope + 1));
-}
-
-
-//==============================================================================
-/**
-*/
-class SimpleEQAudioProcessor  : public juce::AudioProcessor
-{
-public:
-    //==============================================================================
-    SimpleEQAudioProcessor();
-    ~SimpleEQAudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-    
-    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
-    
-    juce::AudioProcessorValueTreeState apvts {*this, nullptr, "Parameters", createParameterLayout()};
-    
-    using BlockType = juce::AudioBuffer<float>;
-    SingleChannelSampleFifo<BlockType> leftChannelFifo { Channel::Left };
-    SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel:: Right };
-
-private:
-
-    MonoChain leftChain, rightChain;
-    
-    void updatePeakFilter(const ChainSettings& chainSettings);
-
-  
-    void updateLowCutFilters(const ChainSettings& chainSettings);
-    void updateHighCutFilters(const ChainSettings& chainSettings);
-    
-    void updateFilters();
-    
-    // Oscillator to test accuracy of spectrum analyzer
-    juce::dsp::Oscillator<float> osc;
-    //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SignalGenerator.h"
+#include "FrequencyResponse.h"
+#include "StateFormat.h"
+
+// fifo that gui thread can use to retrieve blocks that single channel fifo has produced
+#include <array>
+template<typename T>
+struct Fifo
+{
+    void prepare(int numChannels, int numSamples)
+    {
+        static_assert( std::is_same_v<T, juce::AudioBuffer<float>>,
+                      "prepare(numChannels, numSamples) should only be used when the Fifo is holding juce::AudioBuffer<float>");
+        
+        for( auto& buffer : buffers)
+        {
+            buffer.setSize(numChannels,
+                           numSamples,
+                           false,           //clear everything?
+                           true,            //including the extra space?
+                           true);           //avoid reallocating if you can?
+            buffer.clear();
+        }
+        
+        // nothing left over from before, so fifos prepared together start in step
+        fifo.reset();
+    }
+    
+    void prepare(size_t numElements)
+    {
+        for(auto& buffer : buffers )
+        {
+            if constexpr ( std::is_same_v<T, std::vector<float>> )
+            {
+                buffer.clear();
+                buffer.resize(numElements, 0);
+            }
+            else
+            {
+                // fixed size frames (e.g. QuantisedFFTFrame) know how to size themselves
+                buffer.prepare(numElements);
+            }
+        }
+        
+        fifo.reset();
+    }
+    
+    bool push(const T& t)
+    {
+        auto write = fifo.write(1);
+        if( write.blockSize1 > 0 )
+        {
+            buffers[write.startIndex1] = t;
+            return true;
+        }
+        
+        return false;
+    }
+    
+    bool pull(T& t)
+    {
+        auto read = fifo.read(1);
+        if( read.blockSize1 > 0 )
+        {
+            t = buffers[read.startIndex1];
+            return true;
+        }
+        
+        return false;
+    }
+    
+    int getNumAvailableForReading() const
+    {
+        return fifo.getNumReady();
+    }
+    
+    // frees every slot. the fifo needs preparing again before it can be used
+    void release()
+    {
+        for( auto& buffer : buffers )
+            buffer = T();
+        
+        fifo.reset();
+    }
+private:
+    static constexpr int Capacity = 30;
+    std::array<T, Capacity> buffers;
+    juce::AbstractFifo fifo {Capacity};
+};
+
+enum Channel
+{
+    Right, // effectively 0
+    Left //effectively 1
+};
+
+
+// collect samples into blocks of fixed sizes
+template<typename BlockType>
+struct SingleChannelSampleFifo
+{
+    SingleChannelSampleFifo(Channel ch) : channelToUse(ch)
+    {
+        prepared.set(false);
+    }
+    
+    void update(const BlockType& buffer)
+    {
+        jassert(prepared.get());
+        jassert(buffer.getNumChannels() > channelToUse);
+        auto* channelPtr = buffer.getReadPointer(channelToUse);
+        
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            pushNextSampleIntoFifo(channelPtr[i]);
+        }
+    }
+    
+    void prepare(int bufferSize)
+    {
+        prepared.set(false);
+        size.set(bufferSize);
+        
+        bufferToFill.setSize(1,             //channel
+                             bufferSize,    //num smaples
+                             false,         //keepExistingContent
+                             true,          //clear extra space
+                             true);         //avoid reallocating
+        audioBufferFifo.prepare(1, bufferSize);
+        fifoIndex = 0;
+        prepared.set(true);
+    }
+    
+    // gives back the memory allocated by prepare()
+    void release()
+    {
+        prepared.set(false);
+        size.set(0);
+        
+        bufferToFill = BlockType();
+        audioBufferFifo.release();
+        fifoIndex = 0;
+    }
+    //================================================================
+    int getNumCompleteBuffersAvailable() const { return audioBufferFifo.getNumAvailableForReading(); }
+    bool isPrepared() const { return prepared.get(); }
+    int getSize() const { return size.get(); }
+    //================================================================
+    bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
+private:
+    Channel channelToUse;
+    int fifoIndex = 0;
+    Fifo<BlockType> audioBufferFifo;
+    BlockType bufferToFill;
+    juce::Atomic<bool> prepared = false;
+    juce::Atomic<int> size = 0;
+    
+    void pushNextSampleIntoFifo(float sample)
+    {
+        if (fifoIndex == bufferToFill.getNumSamples())
+        {
+            auto ok = audioBufferFifo.push(bufferToFill);
+            
+            juce::ignoreUnused(ok);
+            
+            fifoIndex = 0;
+        }
+        
+        bufferToFill.setSample(0, fifoIndex, sample);
+        ++fifoIndex;
+    }
+};
+
+
+enum Slope
+{
+    Slope_12,
+    Slope_24,
+    Slope_36,
+    Slope_48
+};
+
+// every parameter, in the order the host sees them. indexes parameterSpecs
+enum ParameterIndex
+{
+    LowCutFreqParameter,
+    HighCutFreqParameter,
+    PeakFreqParameter,
+    PeakGainParameter,
+    PeakQualityParameter,
+    LowCutSlopeParameter,
+    HighCutSlopeParameter,
+    LowCutBypassedParameter,
+    PeakBypassedParameter,
+    HighCutBypassedParameter,
+    AnalyzerEnabledParameter,
+    GeneratorTypeParameter,
+    GeneratorLevelParameter,
+    GeneratorFreqParameter,
+    NumParameters
+};
+
+enum ParameterType
+{
+    FloatParameter,
+    ChoiceParameter,
+    BoolParameter
+};
+
+// the choice lists, built once per process (see getChoiceList() in PluginProcessor.cpp)
+enum ParameterChoices
+{
+    NoChoices,
+    SlopeChoices,       // 12, 24, 36, 48 db/Oct, in Slope order
+    GeneratorChoices    // in SignalType order
+};
+
+/*
+ one parameter: its ID (also its name), type and range. choices run 0 .. number of choices - 1
+ and bools 0 .. 1, the default is in the same units as the range
+ */
+struct ParameterSpec
+{
+    ParameterIndex index;
+    const char* id;
+    ParameterType type;
+    float minimum, maximum, interval, skew;
+    float defaultValue;
+    ParameterChoices choices;
+};
+
+inline constexpr std::array<ParameterSpec, NumParameters> parameterSpecs
+{{
+    //Low Cut Frequency, range 20hz-20khz, skew at .33f, starts at 20hz
+    { LowCutFreqParameter,      "LowCut Freq",      FloatParameter,  20.f, 20000.f, 1.f, 0.33f, 20.f, NoChoices },
+    //high Cut Frequency, range 20hz-20khz, skew at .33f, starts at 20khz
+    { HighCutFreqParameter,     "HighCut Freq",     FloatParameter,  20.f, 20000.f, 1.f, 0.33f, 20000.f, NoChoices },
+    //peak frequency, range 20hz-20khz, skew at .33, start at 750hz
+    { PeakFreqParameter,        "Peak Freq",        FloatParameter,  20.f, 20000.f, 1.f, 0.33f, 750.f, NoChoices },
+    //gain for peak frequency, from -24db to 24db, start at 0db
+    { PeakGainParameter,        "Peak Gain",        FloatParameter,  -24.f, 24.f, 0.5f, 1.f, 0.f, NoChoices },
+    // Q factor for peak frequency, range .1 to 10, starts at 1
+    { PeakQualityParameter,     "Peak Quality",     FloatParameter,  0.1f, 10.f, 0.05f, 1.f, 1.f, NoChoices },
+    //high cut and low cut slope, starting at 12 db/Oct
+    { LowCutSlopeParameter,     "LowCut Slope",     ChoiceParameter, 0.f, 3.f, 1.f, 1.f, 0.f, SlopeChoices },
+    { HighCutSlopeParameter,    "HighCut Slope",    ChoiceParameter, 0.f, 3.f, 1.f, 1.f, 0.f, SlopeChoices },
+    // bypass booleans
+    { LowCutBypassedParameter,  "LowCut Bypassed",  BoolParameter,   0.f, 1.f, 1.f, 1.f, 0.f, NoChoices },
+    { PeakBypassedParameter,    "Peak Bypassed",    BoolParameter,   0.f, 1.f, 1.f, 1.f, 0.f, NoChoices },
+    { HighCutBypassedParameter, "HighCut Bypassed", BoolParameter,   0.f, 1.f, 1.f, 1.f, 0.f, NoChoices },
+    { AnalyzerEnabledParameter, "Analyzer Enabled", BoolParameter,   0.f, 1.f, 1.f, 1.f, 1.f, NoChoices },
+    // test signal generator, starts Off
+    { GeneratorTypeParameter,   "Generator Type",   ChoiceParameter, 0.f, 5.f, 1.f, 1.f, 0.f, GeneratorChoices },
+    //level of the test signal, -60db to 0db, starts at -18db
+    { GeneratorLevelParameter,  "Generator Level",  FloatParameter,  -60.f, 0.f, 0.5f, 1.f, -18.f, NoChoices },
+    //sine frequency, same range and skew as the filter frequencies
+    { GeneratorFreqParameter,   "Generator Freq",   FloatParameter,  20.f, 20000.f, 1.f, 0.33f, 1000.f, NoChoices },
+}};
+
+constexpr bool parameterSpecsAreInOrder()
+{
+    for (size_t i = 0; i < parameterSpecs.size(); ++i)
+    {
+        if (parameterSpecs[i].index != static_cast<ParameterIndex>(i))
+            return false;
+    }
+    
+    return true;
+}
+
+static_assert(parameterSpecsAreInOrder(), "parameterSpecs has to list the parameters in ParameterIndex order");
+
+constexpr const char* getParameterID(ParameterIndex index)
+{
+    return parameterSpecs[(size_t) index].id;
+}
+
+// every parameter's raw value, bound once when the processor is made. see loadParameter()
+using ParameterValues = std::array<std::atomic<float>*, NumParameters>;
+
+// a relaxed load: fine on the audio thread, no lookup and no lock
+inline float loadParameter(const ParameterValues& values, ParameterIndex index)
+{
+    return values[(size_t) index]->load(std::memory_order_relaxed);
+}
+
+// every parameter's value at one moment, in ParameterIndex order
+using ParameterSnapshot = std::array<float, NumParameters>;
+
+ParameterSnapshot loadParameters(const ParameterValues& values);
+
+constexpr ParameterSnapshot getDefaultParameters()
+{
+    ParameterSnapshot values {};
+    
+    for (const auto& spec : parameterSpecs)
+        values[(size_t) spec.index] = spec.defaultValue;
+    
+    return values;
+}
+
+struct ChainSettings
+{
+    float peakFreq { 0 }, peakGainInDeccibels { 0 }, peakQuality { 1.f };
+    float lowCutFreq { 0 }, highCutFreq { 0 };
+    Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+    
+    bool lowCutBypassed { false }, peakBypassed { false }, highCutBypassed { false };
+    
+    bool operator==(const ChainSettings& other) const
+    {
+        return peakFreq == other.peakFreq
+            && peakGainInDeccibels == other.peakGainInDeccibels
+            && peakQuality == other.peakQuality
+            && lowCutFreq == other.lowCutFreq
+            && highCutFreq == other.highCutFreq
+            && lowCutSlope == other.lowCutSlope
+            && highCutSlope == other.highCutSlope
+            && lowCutBypassed == other.lowCutBypassed
+            && peakBypassed == other.peakBypassed
+            && highCutBypassed == other.highCutBypassed;
+    }
+    
+    bool operator!=(const ChainSettings& other) const { return !(*this == other); }
+};
+
+ChainSettings getChainSettings(const ParameterSnapshot& parameters);
+ChainSettings getChainSettings(const ParameterValues& values);
+
+// the parameters getChainSettings() reads, so the response curve only listens to these
+inline constexpr std::array<ParameterIndex, 10> chainParameters
+{
+    LowCutFreqParameter, HighCutFreqParameter, PeakFreqParameter, PeakGainParameter, PeakQualityParameter,
+    LowCutSlopeParameter, HighCutSlopeParameter, LowCutBypassedParameter, PeakBypassedParameter, HighCutBypassedParameter
+};
+
+using Filter = juce::dsp::IIR::Filter<float>;
+
+using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
+
+using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
+
+enum ChainPositions
+{
+    LowCut,
+    Peak,
+    HighCut
+};
+
+// the chain's active biquads, for evaluateMagnitude() and friends in FrequencyResponse.h
+ChainSnapshot makeChainSnapshot(const MonoChain& chain, double sampleRate);
+
+using Coefficients = Filter::CoefficientsPtr;
+void updateCoefficients(Coefficients& old, const Coefficients& replacements);
+
+Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate);
+
+template<int Index, typename ChainType, typename CoefficientType>
+void update(ChainType& chain, const CoefficientType& coefficients)
+{
+    updateCoefficients(chain.template get<Index>().coefficients, coefficients[Index]);
+    chain.template setBypassed<Index>(false);
+}
+
+//switches coefficient based on filter slope choice
+template<typename ChainType, typename CoefficientType>
+void updateCutFilter(ChainType& leftLowCut,
+                    const CoefficientType& cutCoefficients,
+                    //const ChainSettings& chainSettings)
+                    const Slope& lowCutSlope)
+{
+    leftLowCut.template setBypassed<0>(true);
+    leftLowCut.template setBypassed<1>(true);
+    leftLowCut.template setBypassed<2>(true);
+    leftLowCut.template setBypassed<3>(true);
+    
+    switch (lowCutSlope)
+    {
+        case Slope_48:
+        {
+            update<3>(leftLowCut, cutCoefficients);
+            //*leftLowCut.template get<3>().coefficients = *cutCoefficients[3];
+            //leftLowCut.template setBypassed<3>(false);
+        }
+        case Slope_36:
+        {
+            update<2>(leftLowCut, cutCoefficients);
+        }
+        case Slope_24:
+        {
+            update<1>(leftLowCut, cutCoefficients);
+        }
+        case Slope_12:
+        {
+            update<0>(leftLowCut, cutCoefficients);
+        }
+    }
+}
+
+inline auto makeLowCutFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq,
+                                                                                       sampleRate,
+                                                                                       2 * (chainSettings.lowCutSlope + 1));
+}
+
+inline auto makeHighCutFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq,
+                                                                                      sampleRate,
+                                                                                      2 * (chainSettings.highCutSlope + 1));
+}
+
+// designs a chain for chainSettings from scratch and snapshots it. for when the processor isn't running one
+ChainSnapshot designChainSnapshot(const ChainSettings& chainSettings, double sampleRate);
+
+
+//==============================================================================
+/**
+*/
+class SimpleEQAudioProcessor  : public juce::AudioProcessor
+{
+public:
+    //==============================================================================
+    SimpleEQAudioProcessor();
+    ~SimpleEQAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+    
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    
+    juce::AudioProcessorValueTreeState apvts {*this, nullptr, "Parameters", createParameterLayout()};
+    
+    const ParameterValues& getParameterValues() const { return parameterValues; }
+    
+    using BlockType = juce::AudioBuffer<float>;
+    SingleChannelSampleFifo<BlockType> leftChannelFifo { Channel::Left };
+    SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel:: Right };
+    
+    // the left channel before the EQ, so the analyzer can measure what the EQ actually does
+    SingleChannelSampleFifo<BlockType> inputChannelFifo { Channel::Left };
+    
+    // the channel fifos only hold memory while at least one analyzer (editor) is attached.
+    // call these from the message thread
+    void attachAnalyzer();
+    void detachAnalyzer();
+    
+    // the input fifo is only prepared and fed while at least one attached analyzer is measuring
+    void startMeasuring();
+    void stopMeasuring();
+    
+    /*
+     held by whoever reads the channel fifos (the analysis pool) for as long as it reads them.
+     preparing or releasing the fifos waits for it, so a reader should only ever try-lock it
+     and come back later if it can't get it
+     */
+    juce::CriticalSection analyzerFifoReadLock;
+    
+    /*
+     the biquads the audio thread is running, published every time it designs new ones.
+     copies them into snapshot and returns true if they're newer than version (0 gets whatever
+     is there), which is updated. message thread only
+     */
+    bool getChainSnapshot(ChainSnapshot& snapshot, uint32_t& version);
+
+private:
+    ParameterValues parameterValues {};
+    std::array<juce::RangedAudioParameter*, NumParameters> parameters {};
+    
+    // every parameter as the current block sees it, see updateBlockParameters()
+    ParameterSnapshot blockParameters = getDefaultParameters();
+    
+    void updateBlockParameters();
+    
+    /*
+     setStateInformation() puts a whole state in incomingState before it sets any parameter,
+     and clears stateIsBeingApplied once it has set them all. in between, blocks take their
+     values from incomingState, so none of them sees half of one state and half of another.
+     the audio thread only try-locks stateLock, and keeps the last block's values if it can't get it
+     */
+    juce::SpinLock stateLock;
+    ParameterSnapshot incomingState {};
+    bool stateIsBeingApplied = false;
+    
+    void applyState(ParameterSnapshot state);
+    
+    // guards the channel fifos. the audio thread only ever try-locks it and skips the analyzer if it can't get it
+    juce::SpinLock analyzerLock;
+    int numAttachedAnalyzers = 0, numMeasuringAnalyzers = 0;
+    int analyzerBlockSize = 0;
+    bool analyzerActive = false;
+    
+    // written under analyzerLock. the audio thread also reads it before taking the lock, to know whether to copy the input
+    std::atomic<bool> measuringActive { false };
+    
+    // the input as it was before the EQ, copied so the lock is only needed for the fifo updates.
+    // empty until something measures, see prepareAnalyzerFifos()
+    BlockType analyzerInputBuffer;
+    
+    void prepareAnalyzerFifos();
+
+    MonoChain leftChain, rightChain;
+    
+    void updatePeakFilter(const ChainSettings& chainSettings);
+
+  
+    void updateLowCutFilters(const ChainSettings& chainSettings);
+    void updateHighCutFilters(const ChainSettings& chainSettings);
+    
+    // designs only when the settings or the rate have changed since last time
+    void updateFilters();
+    
+    ChainSettings designedSettings;
+    double designedSampleRate = 0.0;
+    bool filtersDesigned = false;
+    
+    // the audio thread only try-locks chainSnapshotLock. if the editor has it, the snapshot
+    // stays pending and goes out with the next block
+    juce::SpinLock chainSnapshotLock;
+    ChainSnapshot publishedChainSnapshot, pendingChainSnapshot;
+    bool chainSnapshotPending = false;
+    std::atomic<uint32_t> chainSnapshotVersion { 0 };
+    
+    void publishChainSnapshot();
+    
+    // test signal, replaces the input while the "Generator Type" parameter isn't Off
+    SignalGenerator signalGenerator;
+    float generatorGain = 0.f;
+    
+    void renderSignalGenerator(juce::AudioBuffer<float>& buffer);
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessor)
+};
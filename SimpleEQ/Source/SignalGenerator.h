@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    Test signals for calibrating the EQ and the analyzer.
+
+    Plain C++ on purpose, so the benchmark in Tools/ can build it without JUCE.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// order matches the "Generator Type" parameter's choices
+enum SignalType
+{
+    SignalOff,
+    SignalSine,
+    SignalSweep,
+    SignalWhiteNoise,
+    SignalPinkNoise,
+    SignalImpulse,
+    NumSignalTypes
+};
+
+/*
+ mono test signal generator at unit amplitude, the caller applies the level.
+ nothing calls std::sin per sample:
+  - sine and sweep read a shared wavetable with linear interpolation
+  - the sweep is exponential (equal time per octave), its phase increment is multiplied by
+    a constant every sample
+  - white noise is xorshift32, pink noise is Paul Kellett's filter over that white noise.
+    pink is the dearest signal, roughly a tenth of the worst case filter chain
+    (see Tools/SignalGeneratorBenchmark.cpp)
+  - impulse is a single full scale sample every impulsePeriodSeconds
+ */
+struct SignalGenerator
+{
+    static constexpr int tableSize = 2048;
+    static constexpr double sweepStartHz = 20.0, sweepEndHz = 20000.0, sweepSeconds = 10.0;
+    static constexpr double impulsePeriodSeconds = 0.5;
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        setFrequency(frequency);
+        reset();
+    }
+
+    // starts the current signal from the beginning
+    void reset()
+    {
+        phase = 0.0;
+        sweepIncrement = sweepStartHz / sampleRate;
+        sweepMultiplier = std::pow(sweepEndHz / sweepStartHz, 1.0 / (sweepSeconds * sampleRate));
+        noiseState = 0x9e3779b9u;
+        pink = {};
+        samplesUntilImpulse = 0;
+    }
+
+    void setType(SignalType newType)
+    {
+        if ( newType != type )
+        {
+            type = newType;
+            reset();
+        }
+    }
+
+    // sine only, takes effect without a phase jump
+    void setFrequency(double newFrequency)
+    {
+        frequency = newFrequency;
+        sineIncrement = frequency / sampleRate;
+    }
+
+    SignalType getType() const { return type; }
+
+    void process(float* output, int numSamples)
+    {
+        switch (type)
+        {
+            case SignalSine:        renderSine(output, numSamples); break;
+            case SignalSweep:       renderSweep(output, numSamples); break;
+            case SignalWhiteNoise:  renderWhiteNoise(output, numSamples); break;
+            case SignalPinkNoise:   renderPinkNoise(output, numSamples); break;
+            case SignalImpulse:     renderImpulse(output, numSamples); break;
+            case SignalOff:
+            case NumSignalTypes:
+            default:
+                for (int i = 0; i < numSamples; ++i)
+                    output[i] = 0.f;
+                break;
+        }
+    }
+private:
+    SignalType type = SignalOff;
+    double sampleRate = 44100.0;
+    double frequency = 1000.0;
+
+    // phase in cycles, [0, 1)
+    double phase = 0.0;
+    double sineIncrement = 1000.0 / 44100.0;
+    double sweepIncrement = 0.0, sweepMultiplier = 1.0;
+
+    uint32_t noiseState = 0x9e3779b9u;
+    std::array<float, 7> pink {};
+
+    int samplesUntilImpulse = 0;
+
+    using SineTable = std::array<float, tableSize + 1>;
+
+    static SineTable makeSineTable()
+    {
+        SineTable t {};
+        for (int i = 0; i <= tableSize; ++i)
+            t[(size_t) i] = (float) std::sin(2.0 * 3.14159265358979323846 * i / tableSize);
+        return t;
+    }
+
+    /*
+     one cycle plus a guard point, so interpolation never wraps. built when the plugin
+     is loaded, not on the first sine the audio thread asks for, so process() never
+     fills it or waits on a static's guard
+     */
+    static inline const SineTable sineTable = makeSineTable();
+
+    static float lookup(const SineTable& table, double cycles)
+    {
+        auto position = cycles * tableSize;
+        auto index = (int) position;
+        auto fraction = (float) (position - index);
+
+        return table[(size_t) index] + fraction * (table[(size_t) index + 1] - table[(size_t) index]);
+    }
+
+    void renderSine(float* output, int numSamples)
+    {
+        const auto& table = sineTable;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            output[i] = lookup(table, phase);
+
+            phase += sineIncrement;
+            if ( phase >= 1.0 )
+                phase -= 1.0;
+        }
+    }
+
+    void renderSweep(float* output, int numSamples)
+    {
+        const auto& table = sineTable;
+        const auto endIncrement = sweepEndHz / sampleRate;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            output[i] = lookup(table, phase);
+
+            phase += sweepIncrement;
+            sweepIncrement *= sweepMultiplier;
+
+            if ( phase >= 1.0 )
+            {
+                phase -= 1.0;
+
+                // past the top: start again from the bottom, at a zero crossing so it doesn't click
+                if ( sweepIncrement >= endIncrement )
+                    sweepIncrement = sweepStartHz / sampleRate;
+            }
+        }
+    }
+
+    float nextWhite()
+    {
+        noiseState ^= noiseState << 13;
+        noiseState ^= noiseState >> 17;
+        noiseState ^= noiseState << 5;
+
+        // top 24 bits to [-1, 1)
+        return (float) (int32_t) (noiseState >> 8) * (2.f / 16777216.f) - 1.f;
+    }
+
+    void renderWhiteNoise(float* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = nextWhite();
+    }
+
+    // Kellett's "refined" pink filter, within 0.05dB of -3dB/oct above ~9Hz at 44.1kHz
+    void renderPinkNoise(float* output, int numSamples)
+    {
+        auto& b = pink;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto white = nextWhite();
+
+            b[0] = 0.99886f * b[0] + white * 0.0555179f;
+            b[1] = 0.99332f * b[1] + white * 0.0750759f;
+            b[2] = 0.96900f * b[2] + white * 0.1538520f;
+            b[3] = 0.86650f * b[3] + white * 0.3104856f;
+            b[4] = 0.55000f * b[4] + white * 0.5329522f;
+            b[5] = -0.7616f * b[5] - white * 0.0168980f;
+
+            // the raw sum peaks around +-7, this keeps it under full scale
+            output[i] = (b[0] + b[1] + b[2] + b[3] + b[4] + b[5] + b[6] + white * 0.5362f) * 0.11f;
+            b[6] = white * 0.115926f;
+        }
+    }
+
+    void renderImpulse(float* output, int numSamples)
+    {
+        const auto period = (int) (impulsePeriodSeconds * sampleRate);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if ( samplesUntilImpulse == 0 )
+            {
+                output[i] = 1.f;
+                samplesUntilImpulse = period;
+            }
+            else
+            {
+                output[i] = 0.f;
+            }
+
+            --samplesUntilImpulse;
+        }
+    }
+};
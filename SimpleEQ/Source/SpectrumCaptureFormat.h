@@ -0,0 +1,292 @@
+/*
+  ==============================================================================
+
+    Binary format of the analyzer's spectrum captures, and a small reader for them.
+
+    Plain C++ on purpose, so offline tools (see Tools/SpectrumCaptureToCsv.cpp)
+    can read captures without JUCE.
+
+    A capture file is a header followed by fixed size frames, all little endian
+    whatever the machine that wrote it (writeHeader() and friends below):
+
+      header, headerSize bytes (64 in version 1)
+        char[8]   magic             "SEQSPEC" + '\0'
+        uint32    version           1
+        uint32    headerSize        bytes before the first frame
+        float64   sampleRate        Hz
+        uint32    fftSize           bin k is at k * sampleRate / fftSize Hz
+        uint32    window            0 Blackman-Harris, 1 Hann, 2 Flat Top
+        uint32    numBins           bins per frame, fftSize / 2
+        uint32    frameSize         bytes per frame
+        uint32    capacity          frames the file has room for
+        float32   negativeInfinity  dB of code 0, code 65535 is 0dB
+        uint64    frameCount        frames written so far. updated after every
+                                    frame, so a file still being written can be read
+        uint8[8]  reserved
+
+      frames, frameSize bytes each
+        float64   timestamp         seconds since the capture started
+        uint32    spectrum          0 left, 1 right, 2 mid, 3 side
+        uint32    reserved
+        uint16    codes[numBins]    dB = negativeInfinity * (1 - code / 65535)
+
+    One file holds one analyzer setting (rate, FFT size, window). When a setting
+    changes or the file is full, the capture carries on in the next file.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace SpectrumCaptureFormat
+{
+    constexpr char magic[8] = { 'S', 'E', 'Q', 'S', 'P', 'E', 'C', '\0' };
+    constexpr uint32_t version = 1;
+    constexpr uint16_t maxCode = 65535;
+
+    constexpr uint32_t headerSize = 64;
+    constexpr uint32_t frameHeaderSize = 16;
+
+    // where frameCount is in the header, the writer updates it after every frame
+    constexpr size_t frameCountOffset = 48;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        double sampleRate;
+        uint32_t fftSize;
+        uint32_t window;
+        uint32_t numBins;
+        uint32_t frameSize;
+        uint32_t capacity;
+        float negativeInfinity;
+        uint64_t frameCount;
+    };
+
+    struct FrameHeader
+    {
+        double timestamp;
+        uint32_t spectrum;
+    };
+
+    inline uint32_t getFrameSize(uint32_t numBins)
+    {
+        return (uint32_t) (frameHeaderSize + numBins * sizeof(uint16_t));
+    }
+
+    inline bool isLittleEndian()
+    {
+        const uint32_t one = 1;
+        unsigned char first;
+        std::memcpy(&first, &one, 1);
+        return first == 1;
+    }
+
+    // one value in file order. a single memcpy each way, so a frameCount store isn't torn on little endian machines
+    template<typename T>
+    inline void writeValue(unsigned char* dest, T value)
+    {
+        static_assert( std::is_arithmetic_v<T>, "only numbers are stored" );
+
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+
+        if ( ! isLittleEndian() )
+            std::reverse(bytes, bytes + sizeof(T));
+
+        std::memcpy(dest, bytes, sizeof(T));
+    }
+
+    template<typename T>
+    inline T readValue(const unsigned char* source)
+    {
+        static_assert( std::is_arithmetic_v<T>, "only numbers are stored" );
+
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, source, sizeof(T));
+
+        if ( ! isLittleEndian() )
+            std::reverse(bytes, bytes + sizeof(T));
+
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    // writes headerSize bytes, reserved ones as 0
+    inline void writeHeader(unsigned char* dest, const Header& header)
+    {
+        std::memset(dest, 0, headerSize);
+        std::memcpy(dest, header.magic, sizeof(header.magic));
+        writeValue(dest + 8, header.version);
+        writeValue(dest + 12, header.headerSize);
+        writeValue(dest + 16, header.sampleRate);
+        writeValue(dest + 24, header.fftSize);
+        writeValue(dest + 28, header.window);
+        writeValue(dest + 32, header.numBins);
+        writeValue(dest + 36, header.frameSize);
+        writeValue(dest + 40, header.capacity);
+        writeValue(dest + 44, header.negativeInfinity);
+        writeValue(dest + frameCountOffset, header.frameCount);
+    }
+
+    // reads the headerSize bytes of a version 1 header
+    inline Header readHeader(const unsigned char* source)
+    {
+        Header header {};
+        std::memcpy(header.magic, source, sizeof(header.magic));
+        header.version = readValue<uint32_t>(source + 8);
+        header.headerSize = readValue<uint32_t>(source + 12);
+        header.sampleRate = readValue<double>(source + 16);
+        header.fftSize = readValue<uint32_t>(source + 24);
+        header.window = readValue<uint32_t>(source + 28);
+        header.numBins = readValue<uint32_t>(source + 32);
+        header.frameSize = readValue<uint32_t>(source + 36);
+        header.capacity = readValue<uint32_t>(source + 40);
+        header.negativeInfinity = readValue<float>(source + 44);
+        header.frameCount = readValue<uint64_t>(source + frameCountOffset);
+        return header;
+    }
+
+    // writes getFrameSize(numBins) bytes
+    inline void writeFrame(unsigned char* dest, const FrameHeader& frameHeader, const uint16_t* codes, uint32_t numBins)
+    {
+        writeValue(dest, frameHeader.timestamp);
+        writeValue(dest + 8, frameHeader.spectrum);
+        writeValue(dest + 12, (uint32_t) 0);
+
+        auto* out = dest + frameHeaderSize;
+
+        // the codes are already in file order on little endian machines
+        if ( isLittleEndian() )
+        {
+            std::memcpy(out, codes, numBins * sizeof(uint16_t));
+        }
+        else
+        {
+            for (uint32_t i = 0; i < numBins; ++i)
+                writeValue(out + i * sizeof(uint16_t), codes[i]);
+        }
+    }
+
+    inline const char* getWindowName(uint32_t window)
+    {
+        switch (window)
+        {
+            case 0: return "Blackman-Harris";
+            case 1: return "Hann";
+            case 2: return "Flat Top";
+            default: return "unknown";
+        }
+    }
+
+    inline const char* getSpectrumName(uint32_t spectrum)
+    {
+        switch (spectrum)
+        {
+            case 0: return "left";
+            case 1: return "right";
+            case 2: return "mid";
+            case 3: return "side";
+            default: return "unknown";
+        }
+    }
+
+    struct Frame
+    {
+        double timestamp = 0.0;
+        uint32_t spectrum = 0;
+        std::vector<float> decibels;
+    };
+
+    /*
+     reads a capture frame by frame. open() checks the header, readNextFrame() returns false
+     after the last frame the writer finished (frameCount), so a capture that is still
+     being written reads up to wherever it had got to
+     */
+    struct Reader
+    {
+        bool open(const std::string& path)
+        {
+            stream.open(path, std::ios::binary);
+            error.clear();
+
+            if ( ! stream )
+                return fail("can't open " + path);
+
+            unsigned char headerBytes[headerSize];
+            if ( ! stream.read(reinterpret_cast<char*>(headerBytes), sizeof(headerBytes)) )
+                return fail("file is shorter than the header");
+
+            header = readHeader(headerBytes);
+
+            if ( std::memcmp(header.magic, magic, sizeof(magic)) != 0 )
+                return fail("not a spectrum capture");
+
+            if ( header.version != version )
+                return fail("unsupported version " + std::to_string(header.version));
+
+            if ( header.numBins == 0 || header.frameSize != getFrameSize(header.numBins) )
+                return fail("inconsistent frame size");
+
+            if ( header.headerSize < headerSize )
+                return fail("header is too short");
+
+            stream.seekg(header.headerSize);
+            frameBytes.resize(header.frameSize);
+            nextFrame = 0;
+            return true;
+        }
+
+        bool readNextFrame(Frame& frame)
+        {
+            if ( nextFrame >= header.frameCount )
+                return false;
+
+            if ( ! stream.read(reinterpret_cast<char*>(frameBytes.data()), (std::streamsize) frameBytes.size()) )
+                return fail("file ends after " + std::to_string(nextFrame) + " frames");
+
+            frame.timestamp = readValue<double>(frameBytes.data());
+            frame.spectrum = readValue<uint32_t>(frameBytes.data() + 8);
+            frame.decibels.resize(header.numBins);
+
+            const auto decibelsPerCode = -header.negativeInfinity / (float) maxCode;
+            const auto* codes = frameBytes.data() + frameHeaderSize;
+
+            for (uint32_t i = 0; i < header.numBins; ++i)
+                frame.decibels[i] = header.negativeInfinity + readValue<uint16_t>(codes + i * sizeof(uint16_t)) * decibelsPerCode;
+
+            ++nextFrame;
+            return true;
+        }
+
+        const Header& getHeader() const { return header; }
+
+        double getBinFrequency(uint32_t bin) const { return bin * header.sampleRate / header.fftSize; }
+
+        // why open() or readNextFrame() failed
+        const std::string& getError() const { return error; }
+    private:
+        std::ifstream stream;
+        Header header {};
+        std::vector<unsigned char> frameBytes;
+        uint64_t nextFrame = 0;
+        std::string error;
+
+        bool fail(const std::string& message)
+        {
+            error = message;
+            return false;
+        }
+    };
+}
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    Binary format of the plugin's saved state (getStateInformation and
+    setStateInformation), and its reader and writer.
+
+    Plain C++ like SpectrumCaptureFormat.h. A state is a 16 byte header and one
+    float per parameter, all little endian:
+
+        char[4]   magic             "SEQP"
+        uint32    version           1
+        uint32    numValues         parameters that follow
+        uint32    reserved          0
+        float32   values[numValues] in ParameterIndex order (PluginProcessor.h),
+                                    each in its own units: Hz, dB, choice index, 0 or 1
+
+    Parameters are only ever added to the end of ParameterIndex. A state with
+    fewer values than the build reading it is from an older build, and the
+    parameters it doesn't have keep their defaults. One with more is from a newer
+    build: the values this build knows are read and the rest are ignored. A change
+    that can't be described like that bumps version, and readState() migrates the
+    older versions to the current layout.
+
+    States saved before this format are a juce::ValueTree, which
+    SimpleEQAudioProcessor::setStateInformation still reads.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace StateFormat
+{
+    constexpr char magic[4] = { 'S', 'E', 'Q', 'P' };
+    constexpr uint32_t version = 1;
+    constexpr size_t headerSize = 16;
+
+    constexpr size_t getStateSize(uint32_t numValues)
+    {
+        return headerSize + numValues * sizeof(float);
+    }
+
+    inline bool isLittleEndian()
+    {
+        const uint32_t one = 1;
+        unsigned char first;
+        std::memcpy(&first, &one, 1);
+        return first == 1;
+    }
+
+    inline void writeUInt32(unsigned char* dest, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            dest[i] = (unsigned char) (value >> (8 * i));
+    }
+
+    inline uint32_t readUInt32(const unsigned char* source)
+    {
+        return (uint32_t) source[0] | ((uint32_t) source[1] << 8) | ((uint32_t) source[2] << 16) | ((uint32_t) source[3] << 24);
+    }
+
+    // writes getStateSize(numValues) bytes to dest
+    inline void writeState(void* dest, const float* values, uint32_t numValues)
+    {
+        auto* bytes = static_cast<unsigned char*>(dest);
+
+        std::memcpy(bytes, magic, sizeof(magic));
+        writeUInt32(bytes + 4, version);
+        writeUInt32(bytes + 8, numValues);
+        writeUInt32(bytes + 12, 0);
+
+        auto* out = bytes + headerSize;
+
+        // the values are already in file order on little endian machines
+        if ( isLittleEndian() )
+        {
+            std::memcpy(out, values, numValues * sizeof(float));
+            return;
+        }
+
+        for (uint32_t i = 0; i < numValues; ++i)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, values + i, sizeof(bits));
+            writeUInt32(out + 4 * i, bits);
+        }
+    }
+
+    /*
+     reads a state into values, which should already hold every parameter's default.
+     returns false and leaves values alone if data isn't a state in this format, is cut short,
+     or is from a version this build doesn't know. a value that isn't a finite number keeps
+     its default. doesn't allocate
+     */
+    inline bool readState(const void* data, size_t size, float* values, uint32_t numValues)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+
+        if ( data == nullptr || size < headerSize || std::memcmp(bytes, magic, sizeof(magic)) != 0 )
+            return false;
+
+        const auto stateVersion = readUInt32(bytes + 4);
+        const auto numStored = readUInt32(bytes + 8);
+
+        if ( stateVersion == 0 || stateVersion > version )
+            return false;
+
+        if ( (size - headerSize) / sizeof(float) < numStored )
+            return false;
+
+        // version 1 is the only layout so far. migrations from older versions go here, by version
+        const auto numToRead = numStored < numValues ? numStored : numValues;
+        const auto* in = bytes + headerSize;
+
+        for (uint32_t i = 0; i < numToRead; ++i)
+        {
+            const auto bits = readUInt32(in + 4 * i);
+
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+
+            if ( std::isfinite(value) )
+                values[i] = value;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,383 @@
+/*
+  ==============================================================================
+
+    Compares the cost of the analyzer's multi-resolution view (the
+    MultiResolutionAnalyzer in SimpleEQ/Source/PluginEditor.h: 6 octave stages,
+    a 1024 point FFT every 512 samples of each stage's rate, 8th order
+    Butterworth lowpass before every decimation by 2) with the single FFTs it
+    stands in for, order 2048 and 8192, at the hop PathProducer uses (a quarter
+    of the FFT size).
+
+    Every configuration runs the same per-FFT work as the plugin: copy out of a
+    ring buffer, window, pack left and right into one complex FFT, then
+    separateRealPairPowers() and powerToDecibels() from AnalyzerCore.h. (In the
+    plugin the single FFT converts to dB once per UI tick rather than per FFT, so
+    it costs a little less there than here.) The FFT is a plain radix-2 one, not
+    JUCE's, so the absolute times are only a guide, but every configuration uses
+    the same one. No JUCE is needed:
+
+        g++ -O2 -std=c++17 -I SimpleEQ/Source Tools/AnalyzerBenchmark.cpp -o benchmark
+        ./benchmark
+
+  ==============================================================================
+*/
+
+#include "AnalyzerCore.h"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr double pi = 3.14159265358979323846;
+    constexpr int blockSize = 512;
+    constexpr float negativeInfinity = -48.f;
+
+    using Complex = std::complex<float>;
+
+    // in-place iterative radix-2 FFT with precomputed twiddles and bit reversal
+    struct RadixTwoFFT
+    {
+        explicit RadixTwoFFT(int order) : size(1 << order), twiddles((size_t) size / 2), reversed((size_t) size)
+        {
+            for (int i = 0; i < size / 2; ++i)
+                twiddles[(size_t) i] = std::polar(1.f, (float) (-2.0 * pi * i / size));
+
+            for (int i = 0; i < size; ++i)
+            {
+                int r = 0;
+                for (int bit = 1, rbit = size >> 1; bit < size; bit <<= 1, rbit >>= 1)
+                    if ( i & bit )
+                        r |= rbit;
+
+                reversed[(size_t) i] = r;
+            }
+        }
+
+        void perform(const Complex* input, Complex* output) const
+        {
+            for (int i = 0; i < size; ++i)
+                output[reversed[(size_t) i]] = input[i];
+
+            for (int length = 2; length <= size; length <<= 1)
+            {
+                const int half = length / 2;
+                const int stride = size / length;
+
+                for (int start = 0; start < size; start += length)
+                {
+                    for (int k = 0; k < half; ++k)
+                    {
+                        auto t = twiddles[(size_t) (k * stride)] * output[start + k + half];
+                        output[start + k + half] = output[start + k] - t;
+                        output[start + k] += t;
+                    }
+                }
+            }
+        }
+
+        int size;
+        std::vector<Complex> twiddles;
+        std::vector<int> reversed;
+    };
+
+    std::vector<float> makeBlackmanHarris(int size)
+    {
+        std::vector<float> window((size_t) size);
+
+        for (int i = 0; i < size; ++i)
+        {
+            auto x = 2.0 * pi * i / (size - 1);
+            window[(size_t) i] = (float) (0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2 * x) - 0.01168 * std::cos(3 * x));
+        }
+
+        return window;
+    }
+
+    // AnalysisRingBuffer without JUCE
+    struct RingBuffer
+    {
+        explicit RingBuffer(int capacity) : buffer((size_t) capacity, 0.f) {}
+
+        void push(const float* samples, int numSamples)
+        {
+            const auto capacity = (int) buffer.size();
+            auto first = std::min(numSamples, capacity - writeIndex);
+
+            std::copy(samples, samples + first, buffer.begin() + writeIndex);
+            std::copy(samples + first, samples + numSamples, buffer.begin());
+            writeIndex = (writeIndex + numSamples) % capacity;
+        }
+
+        void copyLatest(float* dest, int numSamples) const
+        {
+            const auto capacity = (int) buffer.size();
+            auto start = (writeIndex - numSamples + capacity) % capacity;
+            auto first = std::min(numSamples, capacity - start);
+
+            std::copy(buffer.begin() + start, buffer.begin() + start + first, dest);
+            std::copy(buffer.begin(), buffer.begin() + (numSamples - first), dest + first);
+        }
+
+        std::vector<float> buffer;
+        int writeIndex = 0;
+    };
+
+    // one real-pair stereo FFT with its buffers, as FFTDataGenerator runs it
+    struct StereoFFT
+    {
+        explicit StereoFFT(int order) :
+        fft(order),
+        window(makeBlackmanHarris(1 << order)),
+        left((size_t) fft.size), right((size_t) fft.size),
+        timeData((size_t) fft.size), spectrumData((size_t) fft.size),
+        first((size_t) fft.size / 2), second((size_t) fft.size / 2),
+        decibels((size_t) fft.size / 2)
+        {
+        }
+
+        void run(const RingBuffer& leftBuffer, const RingBuffer& rightBuffer)
+        {
+            const int size = fft.size;
+            const int numBins = size / 2;
+
+            leftBuffer.copyLatest(left.data(), size);
+            rightBuffer.copyLatest(right.data(), size);
+
+            for (int i = 0; i < size; ++i)
+                timeData[(size_t) i] = Complex(left[(size_t) i] * window[(size_t) i], right[(size_t) i] * window[(size_t) i]);
+
+            fft.perform(timeData.data(), spectrumData.data());
+            separateRealPairPowers(spectrumData.data(), size, false, first.data(), second.data());
+
+            const auto normalise = 0.5f / (float) numBins;
+            powerToDecibels(first.data(), decibels.data(), numBins, normalise * normalise, negativeInfinity);
+            powerToDecibels(second.data(), decibels.data(), numBins, normalise * normalise, negativeInfinity);
+            ++numFFTs;
+        }
+
+        RadixTwoFFT fft;
+        std::vector<float> window, left, right;
+        std::vector<Complex> timeData, spectrumData;
+        std::vector<float> first, second, decibels;
+        long numFFTs = 0;
+    };
+
+    // PathProducer's single FFT: a ring buffer and an FFT every hopSize samples
+    struct SingleFFTAnalyzer
+    {
+        SingleFFTAnalyzer(int order, int hop) :
+        fft(order), leftBuffer(1 << order), rightBuffer(1 << order), hopSize(hop), samplesUntilNextFFT(hop)
+        {
+        }
+
+        void process(const float* leftSamples, const float* rightSamples, int numSamples)
+        {
+            while ( numSamples > 0 )
+            {
+                auto numToWrite = std::min(numSamples, samplesUntilNextFFT);
+                leftBuffer.push(leftSamples, numToWrite);
+                rightBuffer.push(rightSamples, numToWrite);
+
+                leftSamples += numToWrite;
+                rightSamples += numToWrite;
+                numSamples -= numToWrite;
+                samplesUntilNextFFT -= numToWrite;
+
+                if ( samplesUntilNextFFT == 0 )
+                {
+                    fft.run(leftBuffer, rightBuffer);
+                    samplesUntilNextFFT = hopSize;
+                }
+            }
+        }
+
+        StereoFFT fft;
+        RingBuffer leftBuffer, rightBuffer;
+        int hopSize, samplesUntilNextFFT;
+    };
+
+    // transposed direct form II, like juce::dsp::IIR::Filter
+    struct Biquad
+    {
+        float b0 = 1.f, b1 = 0.f, b2 = 0.f, a1 = 0.f, a2 = 0.f;
+        float s1 = 0.f, s2 = 0.f;
+
+        float processSample(float x)
+        {
+            auto y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    Biquad makeLowpass(double frequency, double q)
+    {
+        auto w = 2.0 * pi * frequency / sampleRate;
+        auto alpha = std::sin(w) / (2.0 * q);
+        auto c = std::cos(w);
+        auto a0 = 1.0 + alpha;
+
+        Biquad biquad;
+        biquad.b0 = (float) ((1.0 - c) / 2.0 / a0);
+        biquad.b1 = (float) ((1.0 - c) / a0);
+        biquad.b2 = biquad.b0;
+        biquad.a1 = (float) (-2.0 * c / a0);
+        biquad.a2 = (float) ((1.0 - alpha) / a0);
+        return biquad;
+    }
+
+    // the MultiResolutionAnalyzer's cascade with the same stage layout and decimation
+    struct CascadeAnalyzer
+    {
+        static constexpr int numStages = 6;
+        static constexpr int stageOrder = 10;
+        static constexpr int stageHopSize = (1 << stageOrder) / 2;
+
+        struct Stage
+        {
+            Stage() : left(1 << stageOrder), right(1 << stageOrder) {}
+
+            RingBuffer left, right;
+            int samplesUntilNextFFT = stageHopSize;
+            std::array<Biquad, 4> leftFilters, rightFilters;
+            std::vector<float> leftDecimated = std::vector<float>(blockSize), rightDecimated = std::vector<float>(blockSize);
+            bool keepNextSample = true;
+        };
+
+        CascadeAnalyzer() : fft(stageOrder)
+        {
+            // 8th order Butterworth at 0.15 * rate as 4 biquads
+            const double butterworthQs[] = { 0.50979558, 0.60134489, 0.89997622, 2.56291545 };
+
+            for (auto& stage : stages)
+            {
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    stage.leftFilters[i] = makeLowpass(0.15 * sampleRate, butterworthQs[i]);
+                    stage.rightFilters[i] = stage.leftFilters[i];
+                }
+            }
+        }
+
+        void process(const float* leftSamples, const float* rightSamples, int numSamples)
+        {
+            processStage(0, leftSamples, rightSamples, numSamples);
+        }
+
+        void processStage(int s, const float* leftSamples, const float* rightSamples, int numSamples)
+        {
+            auto& stage = stages[(size_t) s];
+
+            for (int pos = 0; pos < numSamples; )
+            {
+                auto numToWrite = std::min(numSamples - pos, stage.samplesUntilNextFFT);
+                stage.left.push(leftSamples + pos, numToWrite);
+                stage.right.push(rightSamples + pos, numToWrite);
+
+                pos += numToWrite;
+                stage.samplesUntilNextFFT -= numToWrite;
+
+                if ( stage.samplesUntilNextFFT == 0 )
+                {
+                    fft.run(stage.left, stage.right);
+                    stage.samplesUntilNextFFT = stageHopSize;
+                }
+            }
+
+            if ( s + 1 == numStages )
+                return;
+
+            int numDecimated = 0;
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto l = leftSamples[i];
+                auto r = rightSamples[i];
+
+                for (size_t f = 0; f < 4; ++f)
+                {
+                    l = stage.leftFilters[f].processSample(l);
+                    r = stage.rightFilters[f].processSample(r);
+                }
+
+                if ( stage.keepNextSample )
+                {
+                    stage.leftDecimated[(size_t) numDecimated] = l;
+                    stage.rightDecimated[(size_t) numDecimated] = r;
+                    ++numDecimated;
+                }
+
+                stage.keepNextSample = ! stage.keepNextSample;
+            }
+
+            if ( numDecimated > 0 )
+                processStage(s + 1, stage.leftDecimated.data(), stage.rightDecimated.data(), numDecimated);
+        }
+
+        StereoFFT fft;
+        std::array<Stage, numStages> stages;
+    };
+
+    // runs seconds of audio through analyzer in blocks, returns microseconds per second of audio
+    template<typename Analyzer>
+    double microsecondsPerSecondOfAudio(Analyzer& analyzer, const std::vector<float>& left, const std::vector<float>& right, int seconds)
+    {
+        const auto numSamples = (int) left.size();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int second = 0; second < seconds; ++second)
+            for (int pos = 0; pos + blockSize <= numSamples; pos += blockSize)
+                analyzer.process(left.data() + pos, right.data() + pos, blockSize);
+
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / seconds;
+    }
+
+    void printResult(const char* name, double microseconds, long numFFTs, int seconds, double lowestBinWidth)
+    {
+        std::printf("%-28s %8.0f us per second of audio (%5.2f%% of a core) | %5.1f FFTs/s | %5.2fHz bins at the bottom\n",
+                    name, microseconds, microseconds / 1.0e4, (double) numFFTs / seconds, lowestBinWidth);
+    }
+}
+
+int main()
+{
+    constexpr int seconds = 20;
+
+    // one second of stereo noise, played over and over
+    std::mt19937 random (1);
+    std::uniform_real_distribution<float> noise (-1.f, 1.f);
+
+    std::vector<float> left((size_t) sampleRate), right((size_t) sampleRate);
+    for (size_t i = 0; i < left.size(); ++i)
+    {
+        left[i] = noise(random);
+        right[i] = noise(random);
+    }
+
+    SingleFFTAnalyzer order2048 (11, 512), order8192 (13, 2048);
+    CascadeAnalyzer cascade;
+
+    // once through first, so every buffer has been touched
+    microsecondsPerSecondOfAudio(order2048, left, right, 1);
+    microsecondsPerSecondOfAudio(order8192, left, right, 1);
+    microsecondsPerSecondOfAudio(cascade, left, right, 1);
+    order2048.fft.numFFTs = order8192.fft.numFFTs = cascade.fft.numFFTs = 0;
+
+    auto single2048 = microsecondsPerSecondOfAudio(order2048, left, right, seconds);
+    auto single8192 = microsecondsPerSecondOfAudio(order8192, left, right, seconds);
+    auto multiResolution = microsecondsPerSecondOfAudio(cascade, left, right, seconds);
+
+    std::printf("48kHz stereo, %d sample blocks, %d seconds\n", blockSize, seconds);
+    printResult("order 2048, hop 512", single2048, order2048.fft.numFFTs, seconds, sampleRate / 2048);
+    printResult("order 8192, hop 2048", single8192, order8192.fft.numFFTs, seconds, sampleRate / 8192);
+    printResult("multi-resolution, 6 stages", multiResolution, cascade.fft.numFFTs, seconds,
+                sampleRate / (1 << (CascadeAnalyzer::numStages - 1)) / (1 << CascadeAnalyzer::stageOrder));
+    std::printf("multi-resolution costs %.2fx order 2048 and %.2fx order 8192\n",
+                multiResolution / single2048, multiResolution / single8192);
+
+    return 0;
+}
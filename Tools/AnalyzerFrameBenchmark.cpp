@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    Compares the two ways the analyzer has handed an FFT frame on: the whole
+    fftSize * 2 float work buffer as a std::vector<float>, which is what went
+    through the 30 slot Fifo before, and a QuantisedFFTFrame of the bins the
+    path generator draws (SimpleEQ/Source/AnalyzerCore.h).
+
+    Each frame is pushed into and pulled back out of a 30 slot fifo, copied by
+    assignment into preallocated slots like Fifo (PluginProcessor.h) does.
+    Quantising the frame from dB is timed on its own. No JUCE is needed:
+
+        g++ -O2 -std=c++17 -I SimpleEQ/Source Tools/AnalyzerFrameBenchmark.cpp -o benchmark
+        ./benchmark
+
+  ==============================================================================
+*/
+
+#include "AnalyzerCore.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int hopSize = 512;
+    constexpr float negativeInfinity = -48.f;
+
+    // the Fifo's slots and indices without the locking, one frame at a time
+    template<typename T>
+    struct SlotFifo
+    {
+        std::array<T, 30> slots;
+        size_t writeIndex = 0, readIndex = 0;
+
+        void push(const T& t)
+        {
+            slots[writeIndex] = t;
+            writeIndex = (writeIndex + 1) % slots.size();
+        }
+
+        void pull(T& t)
+        {
+            t = slots[readIndex];
+            readIndex = (readIndex + 1) % slots.size();
+        }
+    };
+
+    volatile float sink = 0.f;
+
+    template<typename Function>
+    double microsecondsPerCall(int numCalls, Function&& function)
+    {
+        function();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < numCalls; ++i)
+            function();
+
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / numCalls;
+    }
+
+    void printResult(const char* name, size_t bytesPerFrame, double microseconds)
+    {
+        const auto framesPerSecond = sampleRate / hopSize;
+
+        std::printf("  %-10s %6d bytes/frame | %8.1f kB/s per channel at %.0f frames/s | %6.2f us/frame | %7.2f GB/s copied\n",
+                    name, (int) bytesPerFrame,
+                    bytesPerFrame * framesPerSecond / 1024.0, framesPerSecond,
+                    microseconds,
+                    2.0 * bytesPerFrame / (microseconds * 1000.0));
+    }
+}
+
+int main()
+{
+    for (int order : { 11, 12, 13 })
+    {
+        const int fftSize = 1 << order;
+        const int numBins = fftSize / 2;
+
+        // a plausible spectrum: a slope plus some ripple, inside the displayed range
+        std::vector<float> decibels((size_t) numBins);
+        for (int i = 0; i < numBins; ++i)
+            decibels[(size_t) i] = -6.f - 36.f * (float) i / (float) numBins + 4.f * std::sin(0.1f * (float) i);
+
+        std::vector<float> workBuffer((size_t) fftSize * 2, 0.f);
+        std::copy(decibels.begin(), decibels.end(), workBuffer.begin());
+
+        SlotFifo<std::vector<float>> floatFifo;
+        for (auto& slot : floatFifo.slots)
+            slot.resize(workBuffer.size());
+        std::vector<float> floatFrame(workBuffer.size());
+
+        SlotFifo<FFTFrame> frameFifo;
+        for (auto& slot : frameFifo.slots)
+            slot.prepare((size_t) numBins);
+        FFTFrame frame, pulled;
+        frame.prepare((size_t) numBins);
+        pulled.prepare((size_t) numBins);
+
+        const int numCalls = 200000 >> (order - 11);
+
+        auto floats = microsecondsPerCall(numCalls, [&]
+        {
+            floatFifo.push(workBuffer);
+            floatFifo.pull(floatFrame);
+            sink = sink + floatFrame[0];
+        });
+
+        frame.quantise(decibels.data(), numBins, negativeInfinity);
+
+        auto quantised = microsecondsPerCall(numCalls, [&]
+        {
+            frameFifo.push(frame);
+            frameFifo.pull(pulled);
+            sink = sink + (float) pulled.getCodes()[0];
+        });
+
+        auto quantise = microsecondsPerCall(numCalls, [&]
+        {
+            frame.quantise(decibels.data(), numBins, negativeInfinity);
+            sink = sink + (float) frame.getCodes()[0];
+        });
+
+        float maxError = 0.f;
+        for (int i = 0; i < numBins; ++i)
+            maxError = std::max(maxError, std::abs(pulled.getDecibels(i, negativeInfinity) - decibels[(size_t) i]));
+
+        std::printf("order %d (%d bins), quantisation error %.5f dB max\n", fftSize, numBins, maxError);
+        printResult("float", workBuffer.size() * sizeof(float), floats);
+        printResult("quantised", frame.getSizeInBytes(), quantised);
+        std::printf("  quantising the frame first: %.2f us/frame\n", quantise);
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    Compares powerToDecibels() (SimpleEQ/Source/AnalyzerCore.h) with what the
+    FFTDataGenerator used to do with every frame after the FFT: zero the whole
+    fftSize * 2 float work buffer, divide the numBins magnitudes by numBins, then
+    call juce::Decibels::gainToDecibels on each of them.
+
+    The FFT itself is the same either way and isn't timed, its output is copied
+    in from magnitudes spread over 60dB. gainToDecibels is reproduced as JUCE
+    implements it, so no JUCE is needed:
+
+        g++ -O3 -std=c++17 -I SimpleEQ/Source Tools/DecibelKernelBenchmark.cpp -o benchmark
+        ./benchmark
+
+  ==============================================================================
+*/
+
+#include "AnalyzerCore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace
+{
+    constexpr float negativeInfinity = -48.f;
+
+    // juce::Decibels::gainToDecibels
+    float gainToDecibels(float gain, float minusInfinityDb)
+    {
+        return gain > 0.f ? std::max(minusInfinityDb, std::log10(gain) * 20.f) : minusInfinityDb;
+    }
+
+    volatile float sink = 0.f;
+
+    template<typename Function>
+    double microsecondsPerCall(int numCalls, Function&& function)
+    {
+        function();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < numCalls; ++i)
+            function();
+
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / numCalls;
+    }
+}
+
+int main()
+{
+    std::mt19937 random (1);
+    std::uniform_real_distribution<float> decibelRange (-60.f, 0.f);
+
+    for (int order : { 11, 12, 13 })
+    {
+        const int fftSize = 1 << order;
+        const int numBins = fftSize / 2;
+
+        // what the FFT hands back: magnitudes for the old path, power for the fused kernel
+        std::vector<float> magnitudes((size_t) numBins), power((size_t) numBins);
+        for (int i = 0; i < numBins; ++i)
+        {
+            magnitudes[(size_t) i] = (float) numBins * std::pow(10.f, decibelRange(random) / 20.f);
+            power[(size_t) i] = magnitudes[(size_t) i] * magnitudes[(size_t) i];
+        }
+
+        std::vector<float> workBuffer((size_t) fftSize * 2), reference((size_t) numBins), fused((size_t) numBins);
+
+        const int numCalls = 20000 >> (order - 11);
+
+        auto old = microsecondsPerCall(numCalls, [&]
+        {
+            std::fill(workBuffer.begin(), workBuffer.end(), 0.f);
+            std::copy(magnitudes.begin(), magnitudes.end(), workBuffer.begin());
+
+            for (int i = 0; i < numBins; ++i)
+                workBuffer[(size_t) i] /= (float) numBins;
+
+            for (int i = 0; i < numBins; ++i)
+                reference[(size_t) i] = gainToDecibels(workBuffer[(size_t) i], negativeInfinity);
+
+            sink = sink + reference[0];
+        });
+
+        auto kernel = microsecondsPerCall(numCalls, [&]
+        {
+            std::copy(power.begin(), power.end(), workBuffer.begin());
+            powerToDecibels(workBuffer.data(), fused.data(), numBins, 1.f / ((float) numBins * (float) numBins), negativeInfinity);
+
+            sink = sink + fused[0];
+        });
+
+        float maxError = 0.f;
+        for (int i = 0; i < numBins; ++i)
+            maxError = std::max(maxError, std::abs(fused[(size_t) i] - reference[(size_t) i]));
+
+        std::printf("order %4d, %4d bins: old %6.1f us | fused %5.1f us (%4.1fx) | max error %.4f dB\n",
+                    fftSize, numBins, old, kernel, old / kernel, maxError);
+    }
+
+    return 0;
+}
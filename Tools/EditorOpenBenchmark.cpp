@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    Times opening the editor, headless: constructing SimpleEQAudioProcessorEditor,
+    its first paint (into an image, through createComponentSnapshot), and how long
+    until the response view is complete, for a number of editors open at once,
+    like a mix with many instances.
+
+    Unlike the other tools this needs JUCE and the plugin's sources. Build it as a
+    console app from this file plus SimpleEQ/Source/PluginProcessor.cpp and
+    SimpleEQ/Source/PluginEditor.cpp, with SimpleEQ/JuceLibraryCode and the JUCE
+    modules on the include path and the same modules as the plugin (except the
+    plugin client) and JUCE_MODAL_LOOPS_PERMITTED=1 for runDispatchLoopUntil, then:
+
+        ./editor_benchmark [number of editors, default 30]
+
+    The first paint is a placeholder: the grid is still being rendered on the
+    analysis pool (see ResponseCurveComponent::requestGridLayer) and the analyzer
+    hasn't been made yet. After it, each editor is run like a host would run it,
+    a 512 sample block of a 1kHz sine every 10.7ms and a display refresh every
+    16.7ms (ResponseCurveComponent::refreshNow, there's no display here), until
+    ResponseCurveComponent::isFullyRendered(). "until complete" is that wait,
+    from the end of construction, and includes filling the first FFT window.
+    "complete paint" is the paint of the finished frame. The analyzer is on by
+    default, so it's made on the first refresh either way.
+
+  ==============================================================================
+*/
+
+#include "../SimpleEQ/Source/PluginProcessor.h"
+#include "../SimpleEQ/Source/PluginEditor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    double getMilliseconds()
+    {
+        return juce::Time::getMillisecondCounterHiRes();
+    }
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr double blockMs = 1000.0 * blockSize / sampleRate;
+    constexpr double refreshMs = 1000.0 / 60.0;
+    constexpr double timeoutMs = 5000.0;
+
+    ResponseCurveComponent* findResponseCurve(juce::Component& editor)
+    {
+        for ( auto* child : editor.getChildren() )
+            if ( auto* responseCurve = dynamic_cast<ResponseCurveComponent*>(child) )
+                return responseCurve;
+
+        return nullptr;
+    }
+
+    void printStats(const char* name, std::vector<double> times)
+    {
+        std::sort(times.begin(), times.end());
+
+        double total = 0.0;
+        for ( auto t : times )
+            total += t;
+
+        std::printf("%-15s first %7.2f ms | median %7.2f ms | max %7.2f ms | total %8.2f ms\n",
+                    name,
+                    times.empty() ? 0.0 : times.front(),
+                    times.empty() ? 0.0 : times[times.size() / 2],
+                    times.empty() ? 0.0 : times.back(),
+                    total);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int numEditors = argc > 1 ? juce::jmax(1, juce::String(argv[1]).getIntValue()) : 30;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    // one processor per editor, prepared like a host would
+    std::vector<std::unique_ptr<SimpleEQAudioProcessor>> processors;
+    for ( int i = 0; i < numEditors; ++i )
+    {
+        processors.push_back(std::make_unique<SimpleEQAudioProcessor>());
+        processors.back()->prepareToPlay(sampleRate, blockSize);
+    }
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    double phase = 0.0;
+
+    std::vector<std::unique_ptr<juce::AudioProcessorEditor>> editors;
+    std::vector<double> constructionTimes, firstPaintTimes, untilCompleteTimes, completePaintTimes;
+    int numIncomplete = 0;
+
+    for ( auto& processor : processors )
+    {
+        auto start = getMilliseconds();
+        editors.emplace_back(processor->createEditor());
+        auto constructed = getMilliseconds();
+
+        auto& editor = *editors.back();
+        auto image = editor.createComponentSnapshot(editor.getLocalBounds());
+        auto painted = getMilliseconds();
+
+        constructionTimes.push_back(constructed - start);
+        firstPaintTimes.push_back(painted - constructed);
+
+        auto* responseCurve = findResponseCurve(editor);
+        jassert( responseCurve != nullptr );
+
+        double audioMs = 0.0, nextRefreshMs = 0.0;
+
+        while ( responseCurve != nullptr && ! responseCurve->isFullyRendered() )
+        {
+            auto elapsed = getMilliseconds() - constructed;
+
+            if ( elapsed > timeoutMs )
+                break;
+
+            for ( ; audioMs <= elapsed; audioMs += blockMs )
+            {
+                for ( int channel = 0; channel < buffer.getNumChannels(); ++channel )
+                    for ( int i = 0; i < blockSize; ++i )
+                        buffer.setSample(channel, i, 0.5f * (float) std::sin(phase + i * juce::MathConstants<double>::twoPi * 1000.0 / sampleRate));
+
+                phase = std::fmod(phase + blockSize * juce::MathConstants<double>::twoPi * 1000.0 / sampleRate, juce::MathConstants<double>::twoPi);
+                processor->processBlock(buffer, midi);
+            }
+
+            if ( elapsed >= nextRefreshMs )
+            {
+                responseCurve->refreshNow();
+                nextRefreshMs += refreshMs;
+            }
+
+            // the grid and the analyzer's results come back through the message queue
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(1);
+        }
+
+        auto complete = getMilliseconds();
+
+        if ( responseCurve == nullptr || ! responseCurve->isFullyRendered() )
+            ++numIncomplete;
+
+        image = editor.createComponentSnapshot(editor.getLocalBounds());
+        auto completePainted = getMilliseconds();
+
+        juce::ignoreUnused(image);
+
+        untilCompleteTimes.push_back(complete - constructed);
+        completePaintTimes.push_back(completePainted - complete);
+    }
+
+    std::printf("%d editors open at once\n", numEditors);
+    printStats("construction", constructionTimes);
+    printStats("first paint", firstPaintTimes);
+    printStats("until complete", untilCompleteTimes);
+    printStats("complete paint", completePaintTimes);
+
+    if ( numIncomplete > 0 )
+        std::printf("%d editors weren't complete after %.0f ms\n", numIncomplete, timeoutMs);
+
+    // editors go before their processors, like in a host
+    editors.clear();
+    for ( auto& processor : processors )
+        processor->releaseResources();
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    Compares evaluateMagnitude() (SimpleEQ/Source/FrequencyResponse.h) with the
+    per pixel, per biquad evaluation the response curve used to do, for the most
+    expensive chain: both cuts at 48dB/Oct plus the peak, 9 biquads.
+
+    The reference is juce::dsp::IIR::Coefficients::getMagnitudeForFrequency as
+    JUCE implements it (complex exponential and a power series per call), the
+    biquads are RBJ cookbook designs stored as float like JUCE does, so no JUCE
+    is needed:
+
+        g++ -O2 -std=c++17 -I SimpleEQ/Source Tools/FrequencyResponseBenchmark.cpp -o benchmark
+        ./benchmark
+
+  ==============================================================================
+*/
+
+#include "FrequencyResponse.h"
+
+#include <chrono>
+#include <complex>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr double pi = 3.14159265358979323846;
+
+    // a biquad as JUCE keeps it: b0, b1, b2, a1, a2 as float, normalised by a0
+    using StoredCoefficients = std::array<float, 5>;
+
+    StoredCoefficients normalise(double b0, double b1, double b2, double a0, double a1, double a2)
+    {
+        return { (float) (b0 / a0), (float) (b1 / a0), (float) (b2 / a0), (float) (a1 / a0), (float) (a2 / a0) };
+    }
+
+    StoredCoefficients makeCut(bool highpass, double frequency, double q)
+    {
+        auto w = 2.0 * pi * frequency / sampleRate;
+        auto alpha = std::sin(w) / (2.0 * q);
+        auto c = std::cos(w);
+
+        if ( highpass )
+            return normalise((1 + c) / 2, -(1 + c), (1 + c) / 2, 1 + alpha, -2 * c, 1 - alpha);
+
+        return normalise((1 - c) / 2, 1 - c, (1 - c) / 2, 1 + alpha, -2 * c, 1 - alpha);
+    }
+
+    StoredCoefficients makePeak(double frequency, double q, double gainDb)
+    {
+        auto a = std::pow(10.0, gainDb / 40.0);
+        auto w = 2.0 * pi * frequency / sampleRate;
+        auto alpha = std::sin(w) / (2.0 * q);
+        auto c = std::cos(w);
+
+        return normalise(1 + alpha * a, -2 * c, 1 - alpha * a, 1 + alpha / a, -2 * c, 1 - alpha / a);
+    }
+
+    // juce::dsp::IIR::Coefficients<float>::getMagnitudeForFrequency for a second order filter
+    double getMagnitudeForFrequency(const StoredCoefficients& coefs, double frequency)
+    {
+        constexpr std::complex<double> j (0, 1);
+        const size_t order = 2;
+
+        std::complex<double> numerator = 0.0, denominator = 0.0, factor = 1.0;
+        std::complex<double> jw = std::exp(-2.0 * pi * frequency * j / sampleRate);
+
+        for (size_t n = 0; n <= order; ++n)
+        {
+            numerator += static_cast<double>(coefs[n]) * factor;
+            factor *= jw;
+        }
+
+        denominator = 1.0;
+        factor = jw;
+
+        for (size_t n = order + 1; n <= 2 * order; ++n)
+        {
+            denominator += static_cast<double>(coefs[n]) * factor;
+            factor *= jw;
+        }
+
+        return std::abs(numerator / denominator);
+    }
+
+    volatile float sink = 0.f;
+
+    template<typename Function>
+    double microsecondsPerCall(int numCalls, Function&& function)
+    {
+        function();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < numCalls; ++i)
+            function();
+
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / numCalls;
+    }
+}
+
+int main()
+{
+    // 48dB/Oct Butterworth cuts as 4 biquads each, and a +6dB peak
+    const double butterworthQs[] = { 0.50979558, 0.60134489, 0.89997622, 2.56291545 };
+
+    std::vector<StoredCoefficients> stored;
+    for (auto q : butterworthQs)
+        stored.push_back(makeCut(true, 20.0, q));
+    for (auto q : butterworthQs)
+        stored.push_back(makeCut(false, 20000.0, q));
+    stored.push_back(makePeak(750.0, 1.0, 6.0));
+
+    ChainSnapshot chain;
+    chain.sampleRate = sampleRate;
+    for (const auto& c : stored)
+        chain.add({ c[0], c[1], c[2], c[3], c[4] });
+
+    for (int width : { 500, 1000, 2000 })
+    {
+        std::vector<float> frequencies((size_t) width), reference((size_t) width), batched((size_t) width), adaptive((size_t) width);
+
+        for (int i = 0; i < width; ++i)
+            frequencies[(size_t) i] = (float) (20.0 * std::pow(1000.0, double(i) / double(width)));
+
+        // the old paint loop: every biquad at every pixel, then gainToDecibels
+        auto perPixel = microsecondsPerCall(200, [&]
+        {
+            for (int i = 0; i < width; ++i)
+            {
+                double mag = 1.0;
+                for (const auto& c : stored)
+                    mag *= getMagnitudeForFrequency(c, frequencies[(size_t) i]);
+
+                reference[(size_t) i] = (float) (20.0 * std::log10(std::max(mag, 1.0e-10)));
+            }
+            sink = sink + reference[0];
+        });
+
+        auto batch = microsecondsPerCall(2000, [&]
+        {
+            evaluateMagnitude(chain, frequencies.data(), batched.data(), width);
+            sink = sink + batched[0];
+        });
+
+        auto adaptiveTime = microsecondsPerCall(2000, [&]
+        {
+            evaluateMagnitudeAdaptive(chain, frequencies.data(), adaptive.data(), width);
+            sink = sink + adaptive[0];
+        });
+
+        // compared where the curve is on screen (above -24dB), below that the reference loses precision first
+        float batchError = 0.f, adaptiveError = 0.f;
+        for (int i = 0; i < width; ++i)
+        {
+            if ( reference[(size_t) i] < -24.f )
+                continue;
+
+            batchError = std::max(batchError, std::abs(batched[(size_t) i] - reference[(size_t) i]));
+            adaptiveError = std::max(adaptiveError, std::abs(adaptive[(size_t) i] - reference[(size_t) i]));
+        }
+
+        std::printf("%4d px: per pixel %8.1f us | batched %6.1f us (%5.1fx, max err %.4f dB) | adaptive %6.1f us (%5.1fx, max err %.4f dB)\n",
+                    width, perPixel,
+                    batch, perPixel / batch, batchError,
+                    adaptiveTime, perPixel / adaptiveTime, adaptiveError);
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    Times what loading a session does to every SimpleEQ instance: construct the
+    processor, prepareToPlay, and process one block, for N instances kept alive
+    together. Reports the time per instance for each step and the process's
+    peak memory, and the time to prepare every instance again with the same
+    settings, as hosts do on transport starts. Then attaches an analyzer to
+    every instance, as opening each one's editor would, and reports what the
+    analyzer fifos add per instance.
+
+    Like EditorOpenBenchmark.cpp it needs JUCE and the plugin's sources. Build it
+    as a console app from this file plus SimpleEQ/Source/PluginProcessor.cpp and
+    SimpleEQ/Source/PluginEditor.cpp, with SimpleEQ/JuceLibraryCode and the JUCE
+    modules on the include path and the same modules as the plugin (except the
+    plugin client), then:
+
+        ./instance_benchmark [number of instances, default 500]
+
+    No editor is opened: the session phase runs with the analyzer fifos
+    unallocated, and the attach phase calls attachAnalyzer() directly.
+
+  ==============================================================================
+*/
+
+#include "../SimpleEQ/Source/PluginProcessor.h"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+ #include <psapi.h>
+#else
+ #include <sys/resource.h>
+#endif
+
+namespace
+{
+    // peak resident memory of the whole process so far
+    double getPeakMemoryMegabytes()
+    {
+       #if JUCE_WINDOWS
+        PROCESS_MEMORY_COUNTERS counters {};
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        return (double) counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+       #else
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        #if JUCE_MAC || JUCE_IOS
+         return (double) usage.ru_maxrss / (1024.0 * 1024.0);    // bytes
+        #else
+         return (double) usage.ru_maxrss / 1024.0;               // kilobytes
+        #endif
+       #endif
+    }
+
+    double getMilliseconds()
+    {
+        return juce::Time::getMillisecondCounterHiRes();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int numInstances = argc > 1 ? juce::jmax(1, juce::String(argv[1]).getIntValue()) : 500;
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const auto memoryBefore = getPeakMemoryMegabytes();
+
+    std::vector<std::unique_ptr<SimpleEQAudioProcessor>> instances;
+    instances.reserve((size_t) numInstances);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+
+    double constructMs = 0.0, prepareMs = 0.0, processMs = 0.0;
+
+    for ( int i = 0; i < numInstances; ++i )
+    {
+        auto start = getMilliseconds();
+        instances.push_back(std::make_unique<SimpleEQAudioProcessor>());
+        auto constructed = getMilliseconds();
+
+        auto& processor = *instances.back();
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+        auto prepared = getMilliseconds();
+
+        buffer.clear();
+        processor.processBlock(buffer, midi);
+        auto processed = getMilliseconds();
+
+        constructMs += constructed - start;
+        prepareMs += prepared - constructed;
+        processMs += processed - prepared;
+    }
+
+    const auto memoryAfter = getPeakMemoryMegabytes();
+    const auto n = (double) numInstances;
+
+    std::printf("%d instances at %.0fHz, %d sample blocks\n", numInstances, sampleRate, blockSize);
+    std::printf("construct     %8.3f ms per instance\n", constructMs / n);
+    std::printf("prepare       %8.3f ms per instance\n", prepareMs / n);
+    std::printf("first block   %8.3f ms per instance\n", processMs / n);
+    std::printf("total         %8.3f ms per instance, %.1f ms for all\n", (constructMs + prepareMs + processMs) / n, constructMs + prepareMs + processMs);
+    std::printf("peak memory   %8.1f MB (%.1f MB before, %.1f KB per instance)\n",
+                memoryAfter, memoryBefore, 1024.0 * (memoryAfter - memoryBefore) / n);
+
+    // hosts prepare again with the same settings on transport starts and reactivation
+    auto prepareAgainStart = getMilliseconds();
+    for ( auto& processor : instances )
+        processor->prepareToPlay(sampleRate, blockSize);
+    const auto prepareAgainMs = getMilliseconds() - prepareAgainStart;
+
+    std::printf("prepare again %8.3f ms per instance, same rate and block size\n", prepareAgainMs / n);
+
+    // what an open editor with the analyzer shown costs each instance on the processor side
+    auto start = getMilliseconds();
+    for ( auto& processor : instances )
+    {
+        processor->attachAnalyzer();
+        processor->processBlock(buffer, midi);
+    }
+    const auto attachMs = getMilliseconds() - start;
+
+    const auto memoryAttached = getPeakMemoryMegabytes();
+
+    std::printf("attach        %8.3f ms per instance\n", attachMs / n);
+    std::printf("peak memory   %8.1f MB with analyzers attached, %.1f KB per instance\n",
+                memoryAttached, 1024.0 * (memoryAttached - memoryAfter) / n);
+
+    for ( auto& processor : instances )
+    {
+        processor->detachAnalyzer();
+        processor->releaseResources();
+    }
+
+    return 0;
+}
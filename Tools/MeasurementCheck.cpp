@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    Checks that the transfer function measurement lines its input up with the
+    output after the measurement is stopped and started again. The EQ is left at
+    its defaults, flat between its cuts, so white noise through it should measure
+    about 0dB with a coherence of about 1.
+
+    The processor's fifos are drained the way PathProducer::process does it, one
+    block from each fifo at a time, into the TransferFunctionAnalyzer the editor
+    uses. Before measuring starts again, a few blocks are left unread in the
+    output fifos, as happens between two analyzer ticks. If they were still
+    there when the input fifo starts, the input would lag the output for the
+    whole measurement.
+
+    Like EditorOpenBenchmark.cpp it needs JUCE and the plugin's sources. Build it
+    as a console app from this file plus SimpleEQ/Source/PluginProcessor.cpp and
+    SimpleEQ/Source/PluginEditor.cpp, with SimpleEQ/JuceLibraryCode and the JUCE
+    modules on the include path and the same modules as the plugin (except the
+    plugin client), then:
+
+        ./measurement_check
+
+    It exits with 1 if the magnitude between 100Hz and 5kHz is off by more than
+    0.5dB or the coherence there is below 0.95.
+
+  ==============================================================================
+*/
+
+#include "../SimpleEQ/Source/PluginProcessor.h"
+#include "../SimpleEQ/Source/PluginEditor.h"
+
+#include <cstdio>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int fftOrder = 11;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr int hopSize = fftSize / 4;
+    constexpr float negativeInfinity = -48.f;
+
+    struct Measurement
+    {
+        Measurement() : fft(fftOrder), window((size_t) fftSize, juce::dsp::WindowingFunction<float>::hann)
+        {
+            input.prepare(fftSize);
+            output.prepare(fftSize);
+            analyzer.prepare();
+        }
+
+        // what PathProducer::process does with the fifos, without the analyzer FFTs
+        void drain(SimpleEQAudioProcessor& processor)
+        {
+            auto& left = processor.leftChannelFifo;
+            auto& right = processor.rightChannelFifo;
+            auto& in = processor.inputChannelFifo;
+
+            while ( left.getNumCompleteBuffersAvailable() > 0
+                   && right.getNumCompleteBuffersAvailable() > 0
+                   && in.getNumCompleteBuffersAvailable() > 0 )
+            {
+                if ( ! (left.getAudioBuffer(leftBlock) && right.getAudioBuffer(rightBlock) && in.getAudioBuffer(inputBlock)) )
+                    break;
+
+                auto* outputSamples = leftBlock.getReadPointer(0);
+                auto* inputSamples = inputBlock.getReadPointer(0);
+                auto size = juce::jmin(leftBlock.getNumSamples(), inputBlock.getNumSamples());
+
+                while ( size > 0 )
+                {
+                    auto numToWrite = juce::jmin(size, samplesUntilNextFFT);
+                    output.push(outputSamples, numToWrite);
+                    input.push(inputSamples, numToWrite);
+                    inputSamplesUntilValid = juce::jmax(0, inputSamplesUntilValid - numToWrite);
+
+                    outputSamples += numToWrite;
+                    inputSamples += numToWrite;
+                    size -= numToWrite;
+                    samplesUntilNextFFT -= numToWrite;
+
+                    if ( samplesUntilNextFFT == 0 )
+                    {
+                        if ( inputSamplesUntilValid == 0 )
+                            analyzer.process(input, output, fft, window);
+
+                        samplesUntilNextFFT = hopSize;
+                    }
+                }
+            }
+        }
+
+        // a new measurement, like switching Measure on: nothing until a whole window of input is in
+        void restart()
+        {
+            analyzer.reset();
+            inputSamplesUntilValid = fftSize;
+        }
+
+        juce::dsp::FFT fft;
+        juce::dsp::WindowingFunction<float> window;
+        AnalysisRingBuffer input, output;
+        TransferFunctionAnalyzer<FFTFrame> analyzer;
+
+        juce::AudioBuffer<float> leftBlock, rightBlock, inputBlock;
+        int samplesUntilNextFFT = hopSize;
+        int inputSamplesUntilValid = fftSize;
+    };
+
+    void processNoise(SimpleEQAudioProcessor& processor, juce::AudioBuffer<float>& buffer, juce::Random& random, int numBlocks)
+    {
+        juce::MidiBuffer midi;
+
+        for ( int b = 0; b < numBlocks; ++b )
+        {
+            for ( int i = 0; i < blockSize; ++i )
+            {
+                auto sample = 0.5f * (random.nextFloat() * 2.f - 1.f);
+
+                for ( int channel = 0; channel < buffer.getNumChannels(); ++channel )
+                    buffer.setSample(channel, i, sample);
+            }
+
+            processor.processBlock(buffer, midi);
+        }
+    }
+}
+
+int main()
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    SimpleEQAudioProcessor processor;
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::Random random(1);
+    Measurement measurement;
+
+    processor.attachAnalyzer();
+    processor.startMeasuring();
+
+    // a first measurement, drained every 3 blocks like an analyzer tick
+    for ( int tick = 0; tick < 50; ++tick )
+    {
+        processNoise(processor, buffer, random, 3);
+        measurement.drain(processor);
+    }
+
+    processor.stopMeasuring();
+
+    // the output fifos keep filling while nothing measures, and aren't drained before measuring starts again
+    processNoise(processor, buffer, random, 3);
+
+    processor.startMeasuring();
+    measurement.restart();
+
+    for ( int tick = 0; tick < 100; ++tick )
+    {
+        processNoise(processor, buffer, random, 3);
+        measurement.drain(processor);
+    }
+
+    FFTFrame magnitude, coherence;
+    magnitude.prepare((size_t) fftSize / 2);
+    coherence.prepare((size_t) fftSize / 2);
+
+    const bool measured = measurement.analyzer.getFFTData(MagnitudeTrace, magnitude, negativeInfinity)
+                       && measurement.analyzer.getFFTData(CoherenceTrace, coherence, negativeInfinity);
+
+    float maxError = 0.f, minCoherence = 1.f;
+
+    if ( measured )
+    {
+        const auto binWidth = sampleRate / fftSize;
+
+        for ( int k = (int) std::ceil(100.0 / binWidth); k <= (int) (5000.0 / binWidth); ++k )
+        {
+            // the magnitude trace is shifted down by the +24dB top of its range, see TransferFunctionAnalyzer::getFFTData
+            maxError = juce::jmax(maxError, std::abs(magnitude.getDecibels(k, negativeInfinity) + 24.f));
+            minCoherence = juce::jmin(minCoherence, 1.f - coherence.getDecibels(k, negativeInfinity) / negativeInfinity);
+        }
+    }
+
+    processor.stopMeasuring();
+    processor.detachAnalyzer();
+    processor.releaseResources();
+
+    const bool passed = measured && maxError <= 0.5f && minCoherence >= 0.95f;
+
+    std::printf("flat EQ after stop/start, 100Hz-5kHz: magnitude within %.3f dB of 0, coherence at least %.4f: %s\n",
+                maxError, minCoherence, passed ? "ok" : "FAILED");
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    Converts a spectrum capture (see SimpleEQ/Source/SpectrumCaptureFormat.h) to CSV:
+    one row per frame, the time and spectrum first, then one column per bin
+    in dB, headed by the bin's frequency in Hz.
+
+        g++ -O2 -std=c++17 -I SimpleEQ/Source Tools/SpectrumCaptureToCsv.cpp -o capture2csv
+        ./capture2csv capture.seqspec > capture.csv
+
+    The capture's settings go to stderr.
+
+  ==============================================================================
+*/
+
+#include "SpectrumCaptureFormat.h"
+
+#include <cstdio>
+
+int main(int argc, char* argv[])
+{
+    if ( argc != 2 )
+    {
+        std::fprintf(stderr, "usage: %s <capture file>\n", argv[0]);
+        return 2;
+    }
+
+    SpectrumCaptureFormat::Reader reader;
+    if ( ! reader.open(argv[1]) )
+    {
+        std::fprintf(stderr, "%s: %s\n", argv[1], reader.getError().c_str());
+        return 1;
+    }
+
+    const auto& header = reader.getHeader();
+    std::fprintf(stderr, "%s: %.0fHz, FFT size %u, %s window, %llu of %u frames\n",
+                 argv[1],
+                 header.sampleRate,
+                 header.fftSize,
+                 SpectrumCaptureFormat::getWindowName(header.window),
+                 (unsigned long long) header.frameCount,
+                 header.capacity);
+
+    std::printf("time_s,spectrum");
+    for ( uint32_t bin = 0; bin < header.numBins; ++bin )
+        std::printf(",%.3f", reader.getBinFrequency(bin));
+    std::printf("\n");
+
+    SpectrumCaptureFormat::Frame frame;
+    while ( reader.readNextFrame(frame) )
+    {
+        std::printf("%.6f,%s", frame.timestamp, SpectrumCaptureFormat::getSpectrumName(frame.spectrum));
+        for ( auto decibels : frame.decibels )
+            std::printf(",%.2f", decibels);
+        std::printf("\n");
+    }
+
+    if ( ! reader.getError().empty() )
+    {
+        std::fprintf(stderr, "%s: %s\n", argv[1], reader.getError().c_str());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    Times saving and loading a SimpleEQ instance's state, as a host does for
+    every instance on session save and load, undo and snapshot recall. Compares
+    the binary format in SimpleEQ/Source/StateFormat.h with the ValueTree state
+    the plugin used to save (apvts.state.writeToStream, and readFromData plus
+    replaceState to load), and with loading an old ValueTree state through
+    setStateInformation's fallback.
+
+    Like InstanceStartupBenchmark.cpp it needs JUCE and the plugin's sources.
+    Build it as a console app from this file plus SimpleEQ/Source/PluginProcessor.cpp
+    and SimpleEQ/Source/PluginEditor.cpp, with SimpleEQ/JuceLibraryCode and the
+    JUCE modules on the include path and the same modules as the plugin (except
+    the plugin client), then:
+
+        ./state_benchmark [number of saves and loads, default 20000]
+
+    Loads alternate between two states, so every one of them changes parameters.
+
+  ==============================================================================
+*/
+
+#include "../SimpleEQ/Source/PluginProcessor.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    double getMilliseconds()
+    {
+        return juce::Time::getMillisecondCounterHiRes();
+    }
+
+    void printResult(const char* name, double milliseconds, int numRuns, size_t numBytes)
+    {
+        auto microseconds = 1000.0 * milliseconds / (double) numRuns;
+
+        std::printf("%-24s %8.2f us | %10.0f per second | %5d bytes\n",
+                    name, microseconds, 1.0e6 / microseconds, (int) numBytes);
+    }
+
+    // every parameter somewhere other than its default
+    void setNonDefaultState(SimpleEQAudioProcessor& processor)
+    {
+        for ( auto* parameter : processor.getParameters() )
+            parameter->setValueNotifyingHost(std::fmod(parameter->getValue() + 0.37f, 1.f));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int numRuns = argc > 1 ? juce::jmax(1, juce::String(argv[1]).getIntValue()) : 20000;
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    SimpleEQAudioProcessor processor;
+    processor.prepareToPlay(48000.0, 512);
+
+    // two states to load in turn, in both formats
+    juce::MemoryBlock binaryStates[2], valueTreeStates[2];
+
+    for ( int i = 0; i < 2; ++i )
+    {
+        if ( i == 1 )
+            setNonDefaultState(processor);
+
+        processor.getStateInformation(binaryStates[i]);
+
+        juce::MemoryOutputStream mos(valueTreeStates[i], false);
+        processor.apvts.copyState().writeToStream(mos);
+    }
+
+    juce::MemoryBlock destination;
+
+    auto start = getMilliseconds();
+    for ( int i = 0; i < numRuns; ++i )
+        processor.getStateInformation(destination);
+    printResult("save binary", getMilliseconds() - start, numRuns, destination.getSize());
+
+    start = getMilliseconds();
+    for ( int i = 0; i < numRuns; ++i )
+    {
+        destination.reset();
+        juce::MemoryOutputStream mos(destination, false);
+        processor.apvts.state.writeToStream(mos);
+    }
+    printResult("save ValueTree", getMilliseconds() - start, numRuns, destination.getSize());
+
+    start = getMilliseconds();
+    for ( int i = 0; i < numRuns; ++i )
+    {
+        const auto& state = binaryStates[i & 1];
+        processor.setStateInformation(state.getData(), (int) state.getSize());
+    }
+    printResult("load binary", getMilliseconds() - start, numRuns, binaryStates[1].getSize());
+
+    start = getMilliseconds();
+    for ( int i = 0; i < numRuns; ++i )
+    {
+        const auto& state = valueTreeStates[i & 1];
+        auto tree = juce::ValueTree::readFromData(state.getData(), state.getSize());
+
+        if ( tree.isValid() )
+            processor.apvts.replaceState(tree);
+    }
+    printResult("load ValueTree (old)", getMilliseconds() - start, numRuns, valueTreeStates[1].getSize());
+
+    start = getMilliseconds();
+    for ( int i = 0; i < numRuns; ++i )
+    {
+        const auto& state = valueTreeStates[i & 1];
+        processor.setStateInformation(state.getData(), (int) state.getSize());
+    }
+    printResult("load ValueTree fallback", getMilliseconds() - start, numRuns, valueTreeStates[1].getSize());
+
+    // both formats of the same state should load the same parameters
+    processor.setStateInformation(binaryStates[1].getData(), (int) binaryStates[1].getSize());
+    auto fromBinary = loadParameters(processor.getParameterValues());
+
+    processor.setStateInformation(binaryStates[0].getData(), (int) binaryStates[0].getSize());
+    processor.setStateInformation(valueTreeStates[1].getData(), (int) valueTreeStates[1].getSize());
+    auto fromValueTree = loadParameters(processor.getParameterValues());
+
+    std::printf("formats agree: %s\n", fromBinary == fromValueTree ? "yes" : "NO");
+
+    processor.releaseResources();
+
+    return fromBinary == fromValueTree ? 0 : 1;
+}